@@ -0,0 +1,1676 @@
+#include "mylibrary.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace MyLibrary;
+
+/*----------------------- ALLOCATION COUNTING -------------------------*/
+
+// The memory benchmarks report how many heap allocations a load performs
+// and how many bytes are live. The library's instrumentation already
+// counts every allocation in the process; without it, every allocation
+// goes through here instead, each block carrying its size in a header
+// that keeps the alignment malloc gives.
+#if MYLIBRARY_INSTRUMENTATION
+static size_t heapAllocationsSoFar() { return static_cast<size_t>(instrumentationStats().heapAllocations); }
+static size_t heapBytesLive() { return static_cast<size_t>(instrumentationStats().heapBytesInUse); }
+#else
+static std::atomic<size_t> allocationCount{ 0 };
+static std::atomic<size_t> liveHeapBytes{ 0 };
+static constexpr size_t allocationHeader = alignof(std::max_align_t);
+
+static void* countedAlloc(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    liveHeapBytes.fetch_add(size, std::memory_order_relaxed);
+    if (char* p = static_cast<char*>(std::malloc(size + allocationHeader))) {
+        *reinterpret_cast<std::size_t*>(p) = size;
+        return p + allocationHeader;
+    }
+    throw std::bad_alloc();
+}
+
+static void countedFree(void* p) noexcept {
+    if (!p) return;
+    char* block = static_cast<char*>(p) - allocationHeader;
+    liveHeapBytes.fetch_sub(*reinterpret_cast<std::size_t*>(block), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { countedFree(p); }
+
+static size_t heapAllocationsSoFar() { return allocationCount.load(); }
+static size_t heapBytesLive() { return liveHeapBytes.load(); }
+#endif
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    void report(const std::string& name, size_t ops, double ms) {
+        std::cout << std::left << std::setw(40) << name
+            << std::right << std::setw(12) << std::fixed << std::setprecision(2) << ms << " ms"
+            << std::setw(14) << std::setprecision(1) << (ms * 1e6 / ops) << " ns/op\n";
+    }
+
+    /*------------------- LINEAR-SCAN BASELINE ----------------------------*/
+
+    // Mirrors the pre-index implementation: updates scan the vector for
+    // the ID and deletes run remove_if over all of it.
+    struct LegacyTask {
+        int id;
+        std::string description;
+        Priority priority;
+        bool completed;
+        time_t dueDate;
+    };
+
+    void legacyUpdate(std::vector<LegacyTask>& tasks, int id, bool comp) {
+        for (auto& task : tasks) {
+            if (task.id == id) {
+                task.completed = comp;
+                return;
+            }
+        }
+    }
+
+    void legacyDelete(std::vector<LegacyTask>& tasks, int id) {
+        tasks.erase(std::remove_if(tasks.begin(), tasks.end(),
+            [id](const LegacyTask& t) { return t.id == id; }),
+            tasks.end());
+    }
+
+    // The iostream reader that loadTasksFromFile replaced.
+    void legacyLoad(std::vector<LegacyTask>& tasks, const std::string& filename) {
+        std::ifstream file(filename);
+        if (!file.is_open()) return;
+        tasks.clear();
+        int nextId = 1;
+        while (true) {
+            if (!file.good() || file.peek() == EOF) break;
+            std::string desc;
+            getline(file, desc, '|');
+            if (!file.good()) break;
+            int prioInt = 0;
+            int compInt = 0;
+            time_t due = 0;
+            file >> prioInt;
+            if (!file.good()) break;
+            file >> compInt;
+            if (!file.good()) break;
+            file >> due;
+            if (!file.good()) break;
+            file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            if (desc.empty() || prioInt < HIGHEST || prioInt > LOWEST) continue;
+            LegacyTask task{ nextId++, desc, static_cast<Priority>(prioInt), compInt != 0, due };
+            tasks.push_back(task);
+        }
+    }
+
+    // The per-row setw/endl renderer that displayTasks replaced.
+    void legacyDisplay(const std::vector<LegacyTask>& tasks) {
+        std::cout << std::left << std::setw(5) << "ID"
+            << std::setw(25) << "Description"
+            << std::setw(10) << "Priority"
+            << std::setw(10) << "Status"
+            << std::setw(20) << "Due Date"
+            << std::endl;
+        for (auto& task : tasks) {
+            char buffer[20];
+            tm timeStruct{};
+#ifdef _WIN32
+            bool converted = localtime_s(&timeStruct, &task.dueDate) == 0;
+#else
+            bool converted = localtime_r(&task.dueDate, &timeStruct) != nullptr;
+#endif
+            if (converted) {
+                strftime(buffer, sizeof(buffer), "%Y-%m-%d", &timeStruct);
+            }
+            else {
+                std::snprintf(buffer, sizeof(buffer), "InvalidDate");
+            }
+            std::cout << std::left << std::setw(5) << task.id
+                << std::setw(25) << task.description
+                << std::setw(10) << priorityToString(task.priority)
+                << std::setw(10) << (task.completed ? "Completed" : "Pending")
+                << std::setw(20) << buffer
+                << std::endl;
+        }
+    }
+
+    /*------------------------ FILE GENERATOR -----------------------------*/
+
+    // With uniqueDescriptions every line gets its own text; otherwise the
+    // descriptions repeat, as they do in real lists.
+    void generateTaskFile(const std::string& filename, size_t lines, bool uniqueDescriptions = false) {
+        std::ofstream out(filename, std::ios::binary);
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> pickPrio(HIGHEST, LOWEST);
+        std::uniform_int_distribution<int> pickLen(8, 60);
+        std::uniform_int_distribution<long long> pickDue(1700000000LL, 1800000000LL);
+        std::string desc;
+        for (size_t i = 0; i < lines; ++i) {
+            desc.assign(static_cast<size_t>(pickLen(rng)), 'x');
+            desc[0] = static_cast<char>('A' + i % 26);
+            if (uniqueDescriptions) desc += std::to_string(i);
+            out << desc << '|' << pickPrio(rng) << ' ' << (rng() & 1) << ' ' << pickDue(rng) << '\n';
+        }
+    }
+
+    /*------------------------- BENCHMARKS --------------------------------*/
+
+    void benchIdLookup(size_t taskCount, size_t opCount) {
+        std::cout << "\n-- update/delete by ID: " << taskCount << " tasks, "
+            << opCount << " ops --\n";
+
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> pickId(1, static_cast<int>(taskCount));
+        std::vector<int> updateIds(opCount);
+        for (auto& id : updateIds) id = pickId(rng);
+
+        // Distinct IDs so every delete actually finds its task.
+        std::vector<int> deleteIds(taskCount);
+        for (size_t i = 0; i < taskCount; ++i) deleteIds[i] = static_cast<int>(i + 1);
+        std::shuffle(deleteIds.begin(), deleteIds.end(), rng);
+        deleteIds.resize(std::min(opCount, taskCount));
+
+        std::vector<LegacyTask> legacy;
+        legacy.reserve(taskCount);
+        for (size_t i = 0; i < taskCount; ++i) {
+            legacy.push_back({ static_cast<int>(i + 1), "benchmark task", MEDIUM, false, 0 });
+        }
+
+        auto start = Clock::now();
+        for (int id : updateIds) legacyUpdate(legacy, id, true);
+        report("linear scan updateTask", updateIds.size(), elapsedMs(start));
+
+        start = Clock::now();
+        for (int id : deleteIds) legacyDelete(legacy, id);
+        report("linear scan deleteTask", deleteIds.size(), elapsedMs(start));
+
+        // The indexed store numbers tasks from 1 when it starts empty.
+        for (size_t i = 0; i < taskCount; ++i) {
+            Task::addTask("benchmark task", MEDIUM, 0);
+        }
+
+        start = Clock::now();
+        for (int id : updateIds) Task::updateTask(id, {}, {}, true, {});
+        report("indexed updateTask", updateIds.size(), elapsedMs(start));
+
+        start = Clock::now();
+        for (int id : deleteIds) Task::deleteTask(id);
+        report("indexed deleteTask", deleteIds.size(), elapsedMs(start));
+    }
+
+    void benchLoad(size_t maxLines) {
+        const std::string filename = "bench_tasks.txt";
+        const std::string snapshot = "bench_tasks.bin";
+        for (size_t lines = 10000; lines <= maxLines; lines *= 10) {
+            std::cout << "\n-- load: " << lines << " lines --\n";
+            generateTaskFile(filename, lines);
+
+            std::vector<LegacyTask> legacy;
+            auto start = Clock::now();
+            legacyLoad(legacy, filename);
+            double legacyMs = elapsedMs(start);
+            report("iostream loader", lines, legacyMs);
+            legacy = std::vector<LegacyTask>();
+
+            start = Clock::now();
+            Task::loadTasksFromFile(filename);
+            double mappedMs = elapsedMs(start);
+            report("mapped loader", lines, mappedMs);
+            std::cout << "speedup: " << std::setprecision(2) << (legacyMs / mappedMs) << "x\n";
+
+            Task::saveTasksToFile(snapshot);
+            start = Clock::now();
+            Task::loadTasksFromFile(snapshot);
+            double binaryMs = elapsedMs(start);
+            report("binary snapshot loader", lines, binaryMs);
+            std::cout << "speedup: " << std::setprecision(2) << (legacyMs / binaryMs) << "x\n";
+        }
+        std::remove(filename.c_str());
+        std::remove(snapshot.c_str());
+    }
+
+    // Text load with 1, 2, 4, ... parser threads up to the hardware count.
+    // Every run must produce the same tasks; the checksum below shows it.
+    void benchParallelLoad(size_t lines) {
+        std::cout << "\n-- parallel load: " << lines << " lines --\n";
+        const std::string filename = "bench_tasks.txt";
+        const std::string output = "bench_parallel_out.txt";
+        generateTaskFile(filename, lines);
+        unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+        std::cout << "hardware threads: " << hardware << "\n";
+
+        double serialMs = 0;
+        for (unsigned workers = 1;; workers = std::min(workers * 2, hardware)) {
+            LoadOptions options;
+            options.workers = workers;
+            options.minBytesPerWorker = 1;
+            auto start = Clock::now();
+            Task::loadTasksFromFile(filename, FileFormat::Text, options);
+            double ms = elapsedMs(start);
+            if (workers == 1) serialMs = ms;
+
+            Task::saveTasksToFile(output, FileFormat::Text);
+            std::ifstream saved(output, std::ios::binary);
+            size_t checksum = std::hash<std::string>{}(std::string(
+                std::istreambuf_iterator<char>(saved), std::istreambuf_iterator<char>()));
+
+            report(std::to_string(workers) + " worker(s)", lines, ms);
+            std::cout << "  speedup: " << std::setprecision(2) << (serialMs / ms)
+                << "x, checksum " << std::hex << checksum << std::dec << "\n";
+            if (workers == hardware) break;
+        }
+        std::remove(filename.c_str());
+        std::remove(output.c_str());
+    }
+
+    // One edit followed by a save, both ways: full rewrite vs journal append.
+    void benchSave(size_t taskCount, size_t saveCount) {
+        std::cout << "\n-- edit + save: " << taskCount << " tasks, " << saveCount << " saves --\n";
+        const std::string filename = "bench_tasks.txt";
+        generateTaskFile(filename, taskCount);
+        Task::loadTasksFromFile(filename);
+
+        auto start = Clock::now();
+        for (size_t i = 0; i < saveCount; ++i) {
+            Task::addTask("benchmark edit", HIGH, 0);
+            Task::saveTasksToFile(filename);
+        }
+        report("full rewrite per save", saveCount, elapsedMs(start));
+
+        JournalOptions options;
+        options.syncEveryRecords = 1000000;
+        Task::openJournal(filename, options);
+        start = Clock::now();
+        for (size_t i = 0; i < saveCount; ++i) {
+            Task::addTask("benchmark edit", HIGH, 0);
+            Task::syncJournal();
+        }
+        report("journal append + fsync per save", saveCount, elapsedMs(start));
+        Task::closeJournal();
+
+        std::remove(filename.c_str());
+        std::remove((filename + ".wal").c_str());
+    }
+
+    // Edits with autosave on: per-edit latency on the calling thread (mean
+    // and worst, the worst covering the worker's snapshot capture), how
+    // many writes the edits were coalesced into, and whether the file
+    // matches the list once flushed.
+    void benchAutosave(size_t taskCount, size_t editCount) {
+        std::cout << "\n-- autosave: " << taskCount << " tasks, " << editCount << " edits --\n";
+        const std::string filename = "bench_tasks.txt";
+        generateTaskFile(filename, taskCount);
+        TaskList list;
+        list.loadTasksFromFile(filename);
+
+        AutosaveOptions options;
+        options.delayMs = 20;
+        list.startAutosave(filename, options);
+        std::mt19937 rng(11);
+        double worstMs = 0;
+        auto start = Clock::now();
+        for (size_t i = 0; i < editCount; ++i) {
+            auto editStart = Clock::now();
+            int id = 1 + static_cast<int>(rng() % taskCount);
+            switch (rng() % 3) {
+            case 0: list.addTask("autosave edit", LOW, 1700000000); break;
+            case 1: list.updateTask(id, {}, {}, true, {}); break;
+            default: list.updateTask(id, "autosave update " + std::to_string(i), HIGH, {}, {}); break;
+            }
+            worstMs = std::max(worstMs, elapsedMs(editStart));
+        }
+        report("edit with autosave on", editCount, elapsedMs(start));
+        start = Clock::now();
+        list.flushAutosave();
+        report("final flush", 1, elapsedMs(start));
+        std::cout << "  worst edit: " << std::setprecision(3) << worstMs << " ms, "
+            << list.autosaveWrites() << " file writes\n";
+        list.stopAutosave();
+
+        TaskList reloaded;
+        reloaded.loadTasksFromFile(filename);
+        std::stringstream expected, actual;
+        list.snapshot()->display(expected);
+        reloaded.snapshot()->display(actual);
+        std::cout << "  saved file " << (expected.str() == actual.str() ? "matches" : "DOES NOT MATCH")
+            << " the list\n";
+        std::remove(filename.c_str());
+    }
+
+    // Reminder scheduling on a simulated clock: adds, cancels and re-dates
+    // on a running timing wheel, then steps through a year and a bit in
+    // uneven jumps, checking every reminder fires once, at the first poll
+    // past its time and in time order.
+    void benchReminders(size_t taskCount) {
+        std::cout << "\n-- reminders: " << taskCount << " tasks --\n";
+        const time_t start = 1767268800;  // 2026-01-01 12:00 UTC
+        const time_t lead = 3600;
+        time_t now = start;
+        std::mt19937 rng(17);
+        auto randomDue = [&rng, start]() { return start + static_cast<time_t>(rng() % (366 * 86400)); };
+
+        TaskList list;
+        std::unordered_map<int, time_t> expected;  // ID -> reminder time, for tasks that should fire
+        std::unordered_map<int, bool> fired;
+        time_t previousPoll = start;
+        time_t lastFired = std::numeric_limits<time_t>::min();
+        bool ok = true;
+        ReminderOptions options;
+        options.leadSeconds = lead;
+        options.clock = [&now]() { return now; };
+        list.startReminders([&](const TaskRow& task) {
+            auto it = expected.find(task.id);
+            time_t when = task.dueDate - lead;
+            // Reminder times already past when set fire on the first poll.
+            if (it == expected.end() || it->second != when || fired[task.id]
+                || when > now || (when <= previousPoll && previousPoll != start) || when < lastFired) {
+                ok = false;
+            }
+            fired[task.id] = true;
+            lastFired = when;
+        }, options);
+
+        std::vector<time_t> dues(taskCount);
+        for (time_t& due : dues) due = randomDue();
+        auto begin = Clock::now();
+        for (size_t i = 0; i < taskCount; ++i) {
+            list.addTask("reminder task", MEDIUM, dues[i]);
+        }
+        report("add (schedule)", taskCount, elapsedMs(begin));
+        for (size_t i = 0; i < taskCount; ++i) expected[static_cast<int>(i + 1)] = dues[i] - lead;
+
+        // A quarter completed, a tenth deleted, a tenth moved.
+        std::vector<int> ids(taskCount);
+        for (size_t i = 0; i < taskCount; ++i) ids[i] = static_cast<int>(i + 1);
+        std::shuffle(ids.begin(), ids.end(), rng);
+        size_t completed = taskCount / 4;
+        size_t deleted = taskCount / 10;
+        size_t moved = taskCount / 10;
+        std::vector<time_t> newDues(moved);
+        for (time_t& due : newDues) due = randomDue();
+        begin = Clock::now();
+        for (size_t i = 0; i < completed; ++i) list.updateTask(ids[i], {}, {}, true, {});
+        for (size_t i = completed; i < completed + deleted; ++i) list.deleteTask(ids[i]);
+        report("complete/delete (cancel)", completed + deleted, elapsedMs(begin));
+        begin = Clock::now();
+        for (size_t i = 0; i < moved; ++i) list.updateTask(ids[completed + deleted + i], {}, {}, {}, newDues[i]);
+        report("re-date (reschedule)", moved, elapsedMs(begin));
+        for (size_t i = 0; i < completed + deleted; ++i) expected.erase(ids[i]);
+        for (size_t i = 0; i < moved; ++i) expected[ids[completed + deleted + i]] = newDues[i] - lead;
+        size_t scheduled = list.scheduledReminders();
+
+        size_t polls = 0;
+        size_t firedCount = 0;
+        begin = Clock::now();
+        while (now < start + 400 * 86400) {
+            now += 1 + static_cast<time_t>(rng() % (2 * 86400));
+            lastFired = std::numeric_limits<time_t>::min();
+            firedCount += list.pollReminders();
+            previousPoll = now;
+            ++polls;
+        }
+        report("poll", polls, elapsedMs(begin));
+
+        ok = ok && scheduled == expected.size() && firedCount == expected.size()
+            && fired.size() == expected.size() && list.scheduledReminders() == 0;
+        std::cout << "  " << scheduled << " scheduled, " << firedCount << " fired over " << polls
+            << " polls: " << (ok ? "ok" : "MISMATCH") << "\n";
+    }
+
+    // Paged views over a loaded list: the first page of each view (the
+    // first sorted page builds the index, later ones walk it), then every
+    // page forwards and back again, checked against runQuery, and pages
+    // turned across a compaction.
+    void benchCursor(size_t taskCount) {
+        std::cout << "\n-- cursor: " << taskCount << " tasks --\n";
+        const std::string filename = "bench_tasks.txt";
+        generateTaskFile(filename, taskCount);
+        TaskList list;
+        list.loadTasksFromFile(filename);
+        std::remove(filename.c_str());
+
+        struct View {
+            const char* name;
+            TaskQuery query;
+        };
+        std::vector<View> views(4);
+        views[0].name = "insertion";
+        views[1].name = "pending";
+        views[1].query.completed = false;
+        views[2].name = "priority";
+        views[2].query.orderBy = TaskQuery::Order::Priority;
+        views[3].name = "due date desc";
+        views[3].query.orderBy = TaskQuery::Order::DueDate;
+        views[3].query.ascending = false;
+
+        const size_t reps = 1000;
+        const size_t pageSize = 100;
+        bool ok = true;
+        for (const View& view : views) {
+            auto start = Clock::now();
+            size_t rows = list.openCursor(view.query).next().size();
+            report(std::string("first page, ") + view.name, 1, elapsedMs(start));
+            start = Clock::now();
+            for (size_t i = 0; i < reps; ++i) rows += list.openCursor(view.query).next().size();
+            report(std::string("first page again, ") + view.name, reps, elapsedMs(start));
+            ok = ok && rows == std::min<size_t>(taskCount, 20) * (reps + 1);
+
+            std::vector<int> expected;
+            for (const TaskRow& row : list.runQuery(view.query)) expected.push_back(row.id);
+            std::vector<std::vector<int>> pages;
+            TaskCursor cursor = list.openCursor(view.query, pageSize);
+            start = Clock::now();
+            for (auto page = cursor.next(); !page.empty(); page = cursor.next()) {
+                pages.emplace_back();
+                for (const TaskRow& row : page) pages.back().push_back(row.id);
+                if (!cursor.hasNext()) break;
+            }
+            report(std::string("page through, ") + view.name, expected.size(), elapsedMs(start));
+            std::vector<int> walked;
+            for (const auto& page : pages) walked.insert(walked.end(), page.begin(), page.end());
+            ok = ok && walked == expected;
+            for (size_t i = pages.size(); i-- > 1;) {
+                std::vector<int> ids;
+                for (const TaskRow& row : cursor.previous()) ids.push_back(row.id);
+                ok = ok && ids == pages[i - 1];
+            }
+            ok = ok && !cursor.hasPrevious();
+        }
+
+        // Delete the last task on the third page, the one after it and
+        // every even ID, so the store compacts under the cursor: the next
+        // page starts at the first task left after the deleted one.
+        if (taskCount > 4 * pageSize) {
+            TaskCursor cursor = list.openCursor({}, pageSize);
+            for (int i = 0; i < 3; ++i) cursor.next();
+            int anchor = cursor.current().back().id;
+            list.writeBatch([&]() {
+                list.deleteTask(anchor);
+                list.deleteTask(anchor + 1);
+                for (int id = 2; id <= static_cast<int>(taskCount); id += 2) {
+                    if (id != anchor && id != anchor + 1) list.deleteTask(id);
+                }
+            });
+            std::vector<TaskRow> page = cursor.next();
+            ok = ok && !page.empty() && page.front().id == ((anchor + 2) | 1);
+        }
+
+        // The same with IDs running against insertion order, as a
+        // hand-edited file may have them: delete the last task on the first
+        // page, the one after it and every odd ID.
+        if (taskCount > 4 * pageSize) {
+            const int reversedCount = static_cast<int>(4 * pageSize);
+            {
+                std::ofstream out(filename, std::ios::binary);
+                for (int id = reversedCount; id >= 1; --id) {
+                    out << "Task " << id << "|3 0 1800000000 " << id << '\n';
+                }
+            }
+            TaskList reversed;
+            reversed.loadTasksFromFile(filename);
+            std::remove(filename.c_str());
+            TaskCursor cursor = reversed.openCursor({}, pageSize);
+            int anchor = cursor.next().back().id;
+            reversed.writeBatch([&]() {
+                reversed.deleteTask(anchor);
+                reversed.deleteTask(anchor - 1);
+                for (int id = 1; id <= reversedCount; id += 2) {
+                    if (id != anchor && id != anchor - 1) reversed.deleteTask(id);
+                }
+            });
+            std::vector<TaskRow> page = cursor.next();
+            ok = ok && !page.empty() && page.front().id == ((anchor - 2) & ~1);
+        }
+        std::cout << "  pages match runQuery: " << (ok ? "ok" : "MISMATCH") << "\n";
+    }
+
+    // Discards everything written to it; keeps report output out of timings.
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+
+    // Completion count over the task list: a loop over whole Task objects
+    // (as before the columnar store) vs displayCompletionPercentage's popcount.
+    void benchScan(size_t taskCount, size_t scans) {
+        std::cout << "\n-- completion scan: " << taskCount << " tasks, " << scans << " scans --\n";
+        const std::string filename = "bench_tasks.txt";
+        generateTaskFile(filename, taskCount);
+
+        std::vector<LegacyTask> legacy;
+        legacyLoad(legacy, filename);
+        auto start = Clock::now();
+        size_t completed = 0;
+        for (size_t round = 0; round < scans; ++round) {
+            for (auto& task : legacy) {
+                if (task.completed) completed++;
+            }
+        }
+        report("vector<Task> completion scan", taskCount * scans, elapsedMs(start));
+        legacy = std::vector<LegacyTask>();
+
+        Task::loadTasksFromFile(filename);
+        NullBuffer discard;
+        std::streambuf* console = std::cout.rdbuf(&discard);
+        start = Clock::now();
+        for (size_t round = 0; round < scans; ++round) {
+            Task::displayCompletionPercentage();
+        }
+        double ms = elapsedMs(start);
+        std::cout.rdbuf(console);
+        report("bitset popcount completion", taskCount * scans, ms);
+        std::cout << "(" << completed / scans << " of " << taskCount << " completed)\n";
+        std::remove(filename.c_str());
+    }
+
+    // The original comparator sorts (std::sort over whole tasks, testing
+    // `ascending` in every comparison) vs the first sort after a load,
+    // which radix sorts the keys into the indexes. Serial on both sides.
+    void benchSort(size_t taskCount) {
+        std::cout << "\n-- sort: " << taskCount << " tasks --\n";
+        const std::string filename = "bench_tasks.txt";
+        generateTaskFile(filename, taskCount);
+
+        std::vector<LegacyTask> legacy;
+        legacyLoad(legacy, filename);
+        std::vector<LegacyTask> shuffled = legacy;
+        bool ascending = true;
+        auto start = Clock::now();
+        std::sort(legacy.begin(), legacy.end(), [ascending](const LegacyTask& a, const LegacyTask& b) {
+            return ascending ? (a.priority < b.priority) : (a.priority > b.priority);
+        });
+        report("comparator sort by priority", taskCount, elapsedMs(start));
+        legacy = shuffled;
+        start = Clock::now();
+        std::sort(legacy.begin(), legacy.end(), [ascending](const LegacyTask& a, const LegacyTask& b) {
+            return ascending ? (a.dueDate < b.dueDate) : (a.dueDate > b.dueDate);
+        });
+        report("comparator sort by due date", taskCount, elapsedMs(start));
+        legacy = std::vector<LegacyTask>();
+        shuffled = std::vector<LegacyTask>();
+
+        ParallelOptions options;
+        options.threads = 1;
+        setParallelOptions(options);
+        Task::loadTasksFromFile(filename);
+        start = Clock::now();
+        Task::sortTasksByPriority();
+        report("radix index build (both keys)", taskCount, elapsedMs(start));
+        start = Clock::now();
+        Task::sortTasksByDueDate(false);
+        report("switch to due-date view", 1, elapsedMs(start));
+        setParallelOptions({});
+        std::remove(filename.c_str());
+    }
+
+    // "Pending, priority HIGH or better, due before X, description
+    // containing Y, by due date, top 50": full sort then scan (as the
+    // comparator sorts allowed) vs runQuery's column scan with a top-K
+    // partial sort, and vs runQuery walking the due-date index.
+    void benchQuery(size_t taskCount) {
+        std::cout << "\n-- query top 50: " << taskCount << " tasks --\n";
+        const std::string filename = "bench_tasks.txt";
+        generateTaskFile(filename, taskCount);
+        const time_t dueBefore = 1780000000;
+        const size_t limit = 50;
+
+        std::vector<LegacyTask> legacy;
+        legacyLoad(legacy, filename);
+        auto start = Clock::now();
+        std::sort(legacy.begin(), legacy.end(), [](const LegacyTask& a, const LegacyTask& b) {
+            return a.dueDate < b.dueDate;
+        });
+        std::vector<int> legacyIds;
+        for (auto& task : legacy) {
+            if (!task.completed && task.priority <= HIGH && task.dueDate < dueBefore
+                && task.description.find('C') != std::string::npos) {
+                legacyIds.push_back(task.id);
+                if (legacyIds.size() == limit) break;
+            }
+        }
+        report("full sort + scan", taskCount, elapsedMs(start));
+        legacy = std::vector<LegacyTask>();
+
+        Task::loadTasksFromFile(filename);
+        TaskQuery query;
+        query.completed = false;
+        query.priorityAtMost = HIGH;
+        query.dueBefore = dueBefore;
+        query.descriptionContains = "C";
+        query.orderBy = TaskQuery::Order::DueDate;
+        query.limit = limit;
+        start = Clock::now();
+        std::vector<TaskRow> rows = Task::runQuery(query);
+        report("runQuery (column scan + top-K)", taskCount, elapsedMs(start));
+
+        Task::sortTasksByDueDate();
+        start = Clock::now();
+        rows = Task::runQuery(query);
+        report("runQuery (due-date index walk)", taskCount, elapsedMs(start));
+        std::cout << "(" << rows.size() << " rows, first ID " << (rows.empty() ? 0 : rows[0].id)
+            << "; baseline first ID " << (legacyIds.empty() ? 0 : legacyIds[0]) << ")\n";
+        std::remove(filename.c_str());
+    }
+
+    // Full-text search over descriptions of 3-8 words drawn from a skewed
+    // 20k-word vocabulary ("w0" common, "w19999" rare): index build, size,
+    // per-query latency and the cost of keeping the index up to date.
+    void benchSearch(size_t taskCount) {
+        std::cout << "\n-- search: " << taskCount << " tasks --\n";
+        const std::string filename = "bench_search.txt";
+        {
+            std::ofstream out(filename, std::ios::binary);
+            std::mt19937 rng(11);
+            std::uniform_real_distribution<double> skew(0.0, 1.0);
+            for (size_t i = 0; i < taskCount; ++i) {
+                int words = 3 + static_cast<int>(rng() % 6);
+                for (int w = 0; w < words; ++w) {
+                    double u = skew(rng);
+                    out << (w ? " " : "") << 'w' << static_cast<int>(20000 * u * u * u);
+                }
+                out << '|' << (1 + rng() % 5) << " 0 1700000000\n";
+            }
+        }
+        Task::loadTasksFromFile(filename);
+        std::ifstream sized(filename, std::ios::binary | std::ios::ate);
+        size_t fileBytes = static_cast<size_t>(sized.tellg());
+
+        auto start = Clock::now();
+        Task::searchTasks("w0");
+        report("index build (first search)", taskCount, elapsedMs(start));
+        std::cout << "posting lists: " << Task::searchIndexBytes() / 1024 << " KB (task file "
+            << fileBytes / 1024 << " KB)\n";
+
+        const char* queries[] = { "w19999", "w0", "w1 w2", "w5 w19000", "w19998 OR w19999", "w1999*" };
+        for (const char* query : queries) {
+            const int repeats = 200;
+            size_t hits = 0;
+            start = Clock::now();
+            for (int i = 0; i < repeats; ++i) hits = Task::searchTasks(query).size();
+            double ms = elapsedMs(start);
+            std::cout << std::left << std::setw(24) << query << std::right << std::setw(12)
+                << std::setprecision(1) << (ms * 1000.0 / repeats) << " us/query"
+                << std::setw(12) << hits << " hits\n";
+        }
+
+        const size_t edits = 10000;
+        start = Clock::now();
+        for (size_t i = 0; i < edits; ++i) {
+            int id = static_cast<int>(1 + (i * 7919) % taskCount);
+            Task::updateTask(id, std::string("w3 w17 edited") + std::to_string(i % 100));
+        }
+        report("description update (index kept)", edits, elapsedMs(start));
+        std::remove(filename.c_str());
+    }
+
+    // "What is overdue" and "what is due in the next 7 days": sort by due
+    // date and scan vs the per-day buckets (built by the first summary),
+    // listing through the due-date index, and the cost of keeping the
+    // buckets current.
+    void benchDue(size_t taskCount) {
+        std::cout << "\n-- overdue / due soon: " << taskCount << " tasks --\n";
+        const std::string filename = "bench_tasks.txt";
+        generateTaskFile(filename, taskCount);
+        const int open = std::numeric_limits<int>::min();
+
+        std::vector<LegacyTask> legacy;
+        legacyLoad(legacy, filename);
+        const time_t now = std::time(nullptr);
+        auto start = Clock::now();
+        std::sort(legacy.begin(), legacy.end(), [](const LegacyTask& a, const LegacyTask& b) {
+            return a.dueDate < b.dueDate;
+        });
+        size_t legacyOverdue = 0, legacySoon = 0;
+        for (auto& task : legacy) {
+            if (task.dueDate >= now + 7 * 86400) break;
+            if (task.completed) continue;
+            ++(task.dueDate < now ? legacyOverdue : legacySoon);
+        }
+        report("sort + scan", taskCount, elapsedMs(start));
+        legacy = std::vector<LegacyTask>();
+
+        Task::loadTasksFromFile(filename);
+        start = Clock::now();
+        DueCounts overdue = Task::countDue(open, 0);
+        report("bucket build (first summary)", taskCount, elapsedMs(start));
+
+        const int repeats = 1000;
+        DueCounts soon;
+        start = Clock::now();
+        for (int i = 0; i < repeats; ++i) {
+            overdue = Task::countDue(open, 0);
+            soon = Task::countDue(0, 7);
+        }
+        std::cout << std::left << std::setw(40) << "overdue + due-soon counts" << std::right
+            << std::setw(12) << std::setprecision(1) << (elapsedMs(start) * 1000.0 / repeats)
+            << " us\n";
+        std::cout << "(" << overdue.pending << " overdue, " << soon.pending
+            << " due soon; baseline " << legacyOverdue << ", " << legacySoon << ")\n";
+
+        Task::sortTasksByDueDate();
+        start = Clock::now();
+        size_t listed = 0;
+        for (int i = 0; i < repeats; ++i) listed = Task::tasksDue(0, 7, false).size();
+        std::cout << std::left << std::setw(40) << "list pending due soon" << std::right
+            << std::setw(12) << std::setprecision(1) << (elapsedMs(start) * 1000.0 / repeats)
+            << " us" << std::setw(12) << listed << " rows\n";
+
+        const size_t edits = 100000;
+        start = Clock::now();
+        for (size_t i = 0; i < edits; ++i) {
+            int id = static_cast<int>(1 + (i * 7919) % taskCount);
+            if (i % 2) Task::updateTask(id, {}, {}, true, {});
+            else Task::updateTask(id, {}, {}, {}, now + static_cast<time_t>(i % 30) * 86400);
+        }
+        report("completion/due updates (kept)", edits, elapsedMs(start));
+        std::remove(filename.c_str());
+    }
+
+    // Polling the completion statistics: a full pass over the tasks per
+    // poll vs reading the running counters.
+    void benchStats(size_t taskCount, size_t polls) {
+        std::cout << "\n-- statistics: " << taskCount << " tasks, " << polls << " polls --\n";
+        const std::string filename = "bench_tasks.txt";
+        generateTaskFile(filename, taskCount);
+
+        std::vector<LegacyTask> legacy;
+        legacyLoad(legacy, filename);
+        size_t legacyCompleted = 0;
+        auto start = Clock::now();
+        for (size_t i = 0; i < polls; ++i) {
+            legacyCompleted = 0;
+            for (auto& task : legacy) {
+                if (task.completed) ++legacyCompleted;
+            }
+        }
+        report("full scan per poll", polls, elapsedMs(start));
+        legacy = std::vector<LegacyTask>();
+
+        Task::loadTasksFromFile(filename);
+        start = Clock::now();
+        TaskStats stats = Task::statistics();
+        report("first poll (builds due buckets)", 1, elapsedMs(start));
+        start = Clock::now();
+        for (size_t i = 0; i < polls; ++i) stats = Task::statistics();
+        report("Task::statistics", polls, elapsedMs(start));
+        std::cout << "(" << stats.completed << " completed, " << stats.overdue
+            << " overdue; baseline " << legacyCompleted << " completed)\n";
+        std::remove(filename.c_str());
+    }
+
+    // Checks one snapshot: its size matches its rows, IDs are unique and
+    // both halves of every pair ("<producer>:<round> a" / "... b", always
+    // added, completed and deleted together in one writeBatch) are present
+    // with the same status. Returns the number of violations.
+    size_t checkSnapshot(const TaskSnapshot& snapshot) {
+        size_t rows = 0, violations = 0;
+        std::unordered_map<int, int> seenIds;
+        std::unordered_map<std::string_view, int> pairs;  // +1/+2 per half, +4 if completed
+        snapshot.forEach([&](const TaskRow& row) {
+            ++rows;
+            if (seenIds[row.id]++ != 0) ++violations;
+            if (row.description.size() < 3) return;
+            std::string_view key = row.description.substr(0, row.description.size() - 2);
+            pairs[key] += (row.description.back() == 'a' ? 1 : 2) + (row.completed ? 4 : 0);
+        });
+        for (auto& entry : pairs) {
+            if (entry.second != 3 && entry.second != 11) ++violations;
+        }
+        return violations + (rows != snapshot.size());
+    }
+
+    // Concurrent access: a stress run (producer threads adding pairs of
+    // tasks in batches, an editor completing and deleting pairs, readers
+    // checking every snapshot they take), then read/write throughput as
+    // readers are added next to one batching writer.
+    void benchConcurrent(size_t baseTasks, size_t rounds) {
+        unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+        unsigned producers = std::max(2u, hardware);
+        std::cout << "\n-- concurrent: " << producers << " producers x " << rounds
+            << " batches, then " << baseTasks << " tasks --\n";
+        const std::string filename = "bench_tasks.txt";
+        const time_t due = 1750000000;
+        generateTaskFile(filename, 0);
+        Task::loadTasksFromFile(filename);
+        Task::setConcurrentAccess(true);
+
+        std::atomic<bool> producing{ true };
+        std::atomic<size_t> violations{ 0 }, snapshotsChecked{ 0 }, deletedPairs{ 0 };
+        auto start = Clock::now();
+        std::vector<std::thread> threads;
+        for (unsigned p = 0; p < producers; ++p) {
+            threads.emplace_back([p, rounds, due]() {
+                for (size_t round = 0; round < rounds; ++round) {
+                    std::string key = std::to_string(p) + ":" + std::to_string(round);
+                    Task::writeBatch([&key, due]() {
+                        Task::addTask(key + " a", MEDIUM, due);
+                        Task::addTask(key + " b", MEDIUM, due);
+                    });
+                }
+            });
+        }
+        std::thread editor([&producing, &deletedPairs]() {
+            std::mt19937 rng(5);
+            while (producing) {
+                // A pair's halves got consecutive IDs inside one batch.
+                std::vector<int> firstHalves;
+                Task::snapshot()->forEach([&firstHalves](const TaskRow& row) {
+                    if (row.description.back() == 'a' && !row.completed) firstHalves.push_back(row.id);
+                });
+                if (firstHalves.empty()) continue;
+                int id = firstHalves[rng() % firstHalves.size()];
+                bool remove = rng() % 3 == 0;
+                Task::writeBatch([id, remove]() {
+                    if (remove) {
+                        Task::deleteTask(id);
+                        Task::deleteTask(id + 1);
+                    }
+                    else {
+                        Task::updateTask(id, {}, {}, true);
+                        Task::updateTask(id + 1, {}, {}, true);
+                    }
+                });
+                if (remove) ++deletedPairs;
+            }
+        });
+        std::vector<std::thread> readers;
+        for (unsigned r = 0; r < 2; ++r) {
+            readers.emplace_back([&producing, &violations, &snapshotsChecked]() {
+                uint64_t lastVersion = 0;
+                while (producing) {
+                    std::shared_ptr<const TaskSnapshot> snapshot = Task::snapshot();
+                    violations += checkSnapshot(*snapshot) + (snapshot->version() < lastVersion);
+                    lastVersion = snapshot->version();
+                    ++snapshotsChecked;
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        producing = false;
+        editor.join();
+        for (auto& reader : readers) reader.join();
+        report("stress (batched adds)", producers * rounds, elapsedMs(start));
+
+        std::shared_ptr<const TaskSnapshot> last = Task::snapshot();
+        size_t expected = 2 * (producers * rounds - deletedPairs);
+        violations += checkSnapshot(*last) + (last->size() != expected)
+            + (Task::statistics().total != expected);
+        std::cout << "stress: " << snapshotsChecked << " snapshots checked, "
+            << deletedPairs << " pairs deleted, " << last->size() << " tasks: "
+            << (violations == 0 ? "ok" : std::to_string(violations) + " VIOLATIONS") << "\n";
+        Task::setConcurrentAccess(false);
+
+        // Throughput: one writer adding batches of 16 while readers walk
+        // snapshots, for half a second per reader count.
+        generateTaskFile(filename, baseTasks);
+        for (unsigned readerCount = 0; readerCount <= std::max(2u, 2 * hardware);
+            readerCount = readerCount ? 2 * readerCount : 1) {
+            Task::loadTasksFromFile(filename);
+            Task::setConcurrentAccess(true);
+            std::atomic<bool> running{ true };
+            std::atomic<size_t> writes{ 0 }, walks{ 0 }, rowsWalked{ 0 };
+            std::thread writer([&running, &writes, due]() {
+                while (running) {
+                    Task::writeBatch([due]() {
+                        for (int i = 0; i < 16; ++i) Task::addTask("concurrent write", LOW, due);
+                    });
+                    writes += 16;
+                }
+            });
+            readers.clear();
+            for (unsigned r = 0; r < readerCount; ++r) {
+                readers.emplace_back([&running, &walks, &rowsWalked]() {
+                    while (running) {
+                        size_t rows = 0;
+                        Task::snapshot()->forEach([&rows](const TaskRow&) { ++rows; });
+                        rowsWalked += rows;
+                        ++walks;
+                    }
+                });
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            running = false;
+            writer.join();
+            for (auto& reader : readers) reader.join();
+            std::cout << std::setw(3) << readerCount << " readers: " << std::setw(10)
+                << writes * 2 << " writes/s" << std::setw(10) << walks * 2 << " snapshot walks/s"
+                << std::setw(12) << rowsWalked * 2 << " rows/s\n";
+            Task::setConcurrentAccess(false);
+        }
+        std::remove(filename.c_str());
+    }
+
+    // First sort after a load (which builds the sorted indexes) and the
+    // status filter, serial vs on all hardware threads, 10k tasks upwards.
+    void benchSortFilter(size_t maxTasks) {
+        const std::string filename = "bench_tasks.txt";
+        unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+        for (size_t taskCount = 10000; taskCount <= maxTasks; taskCount *= 10) {
+            std::cout << "\n-- sort/filter: " << taskCount << " tasks, up to "
+                << hardware << " threads --\n";
+            generateTaskFile(filename, taskCount);
+
+            double serialSortMs = 0, serialFilterMs = 0, sortMs = 0, filterMs = 0;
+            for (unsigned threads : { 1u, hardware }) {
+                ParallelOptions options;
+                options.threads = threads;
+                options.minParallelTasks = 0;
+                setParallelOptions(options);
+                Task::loadTasksFromFile(filename);
+
+                NullBuffer discard;
+                std::streambuf* console = std::cout.rdbuf(&discard);
+                auto start = Clock::now();
+                Task::filterTasksByStatus(true);
+                filterMs = elapsedMs(start);
+                start = Clock::now();
+                Task::sortTasksByDueDate();
+                sortMs = elapsedMs(start);
+                std::cout.rdbuf(console);
+
+                if (threads == 1) {
+                    serialSortMs = sortMs;
+                    serialFilterMs = filterMs;
+                }
+                std::string label = " (" + std::to_string(threads) + " thread(s))";
+                report("filter completed" + label, taskCount, filterMs);
+                report("first due-date sort" + label, taskCount, sortMs);
+                if (threads == hardware) break;
+            }
+            if (hardware > 1) {
+                std::cout << "speedup: sort " << std::setprecision(2) << (serialSortMs / sortMs)
+                    << "x, filter " << (serialFilterMs / filterMs) << "x\n";
+            }
+        }
+        setParallelOptions({});
+        std::remove(filename.c_str());
+    }
+
+    // displayTasks with stdout redirected to a file, old renderer vs new.
+    void benchRender(size_t taskCount) {
+        std::cout << "\n-- render to file: " << taskCount << " rows --\n";
+        const std::string filename = "bench_tasks.txt";
+        const std::string output = "bench_render.txt";
+        generateTaskFile(filename, taskCount);
+
+        std::vector<LegacyTask> legacy;
+        legacyLoad(legacy, filename);
+        Task::loadTasksFromFile(filename);
+
+        auto timeRender = [&](const char* name, auto&& render) {
+            std::ofstream file(output, std::ios::binary);
+            std::streambuf* console = std::cout.rdbuf(file.rdbuf());
+            auto start = Clock::now();
+            render();
+            double ms = elapsedMs(start);
+            std::cout.rdbuf(console);
+            report(name, taskCount, ms);
+            std::cout << "  " << std::setprecision(0) << (taskCount / (ms / 1000.0)) << " rows/s\n";
+        };
+        timeRender("setw + endl per row", [&] { legacyDisplay(legacy); });
+        timeRender("buffered table writer", [] { Task::displayTasks(); });
+
+        std::remove(filename.c_str());
+        std::remove(output.c_str());
+    }
+
+    // runBatch over a generated script: 40% add, 30% complete,
+    // 20% priority updates, 10% deletes, against an empty task file.
+    void benchBatch(size_t commandCount) {
+        std::cout << "\n-- batch mode: " << commandCount << " commands --\n";
+        const std::string filename = "bench_batch.txt";
+        std::remove(filename.c_str());
+        std::remove((filename + ".wal").c_str());
+
+        std::mt19937 rng(3);
+        std::stringstream script;
+        int added = 0;
+        for (size_t i = 0; i < commandCount; ++i) {
+            int roll = static_cast<int>(rng() % 10);
+            int id = added > 0 ? static_cast<int>(1 + rng() % added) : 0;
+            if (roll < 4 || id == 0) {
+                script << "add " << (1 + rng() % 5) << " 2025-0" << (1 + rng() % 9) << "-15 scripted task "
+                    << i << '\n';
+                ++added;
+            }
+            else if (roll < 7) {
+                script << "complete " << id << '\n';
+            }
+            else if (roll < 9) {
+                script << "update " << id << " priority " << (1 + rng() % 5) << '\n';
+            }
+            else {
+                script << "delete " << id << '\n';
+            }
+        }
+
+        // Deletes of already-deleted IDs warn on stderr; keep that out of the timing.
+        NullBuffer discard;
+        std::streambuf* errors = std::cerr.rdbuf(&discard);
+        auto start = Clock::now();
+        size_t failed = runBatch(script, filename);
+        double ms = elapsedMs(start);
+        std::cerr.rdbuf(errors);
+        report("runBatch (incl. final save)", commandCount, ms);
+        std::cout << "  " << std::setprecision(0) << (commandCount / (ms / 1000.0)) << " commands/s, "
+            << failed << " rejected\n";
+
+        std::remove(filename.c_str());
+        std::remove((filename + ".wal").c_str());
+    }
+
+    size_t peakResidentKb() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters{};
+        GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+        return counters.PeakWorkingSetSize / 1024;
+#else
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<size_t>(usage.ru_maxrss);  // kilobytes on Linux
+#endif
+    }
+
+    // Fixed cost of a TaskList: heap bytes per empty list, per list once
+    // each holds a few tasks, then the time to add to and poll all of them.
+    // Everything must be freed again when the lists go away.
+    void benchLists(size_t listCount, size_t tasksPerList) {
+        std::cout << "\n-- lists: " << listCount << " lists, " << tasksPerList << " tasks each --\n";
+        size_t baseline = heapBytesLive();
+        std::vector<std::unique_ptr<TaskList>> lists;
+        lists.reserve(listCount);
+
+        auto start = Clock::now();
+        for (size_t i = 0; i < listCount; ++i) lists.push_back(std::make_unique<TaskList>());
+        report("create empty list", listCount, elapsedMs(start));
+        size_t emptyBytes = heapBytesLive() - baseline;
+
+        start = Clock::now();
+        for (size_t t = 0; t < tasksPerList; ++t) {
+            for (size_t i = 0; i < listCount; ++i) {
+                lists[i]->addTask("list task " + std::to_string(t), static_cast<Priority>(1 + t % 5),
+                    static_cast<time_t>(1700000000 + t * 3600));
+            }
+        }
+        report("addTask", listCount * tasksPerList, elapsedMs(start));
+        size_t filledBytes = heapBytesLive() - baseline;
+
+        start = Clock::now();
+        size_t total = 0;
+        for (auto& list : lists) total += list->statistics().total;
+        report("statistics per list", listCount, elapsedMs(start));
+
+        std::cout << "sizeof(TaskList): " << sizeof(TaskList) << " bytes\n"
+            << "heap per empty list (object included): " << emptyBytes / std::max<size_t>(listCount, 1) << " bytes\n"
+            << "heap per list with " << tasksPerList << " tasks: "
+            << filledBytes / std::max<size_t>(listCount, 1) << " bytes\n";
+        lists.clear();
+        lists.shrink_to_fit();
+        size_t leaked = heapBytesLive() - baseline;
+        std::cout << "(" << total << " tasks counted, expected " << listCount * tasksPerList
+            << "; " << leaked << " bytes left after destroying the lists)\n";
+    }
+
+    // Heap allocations and peak RSS of one text load. Peak RSS covers the
+    // whole process, so run this mode on its own.
+    void benchMemory(size_t lines, bool uniqueDescriptions) {
+        std::cout << "\n-- memory: load of " << lines << " lines ("
+            << (uniqueDescriptions ? "unique" : "repeating") << " descriptions) --\n";
+        const std::string filename = "bench_tasks.txt";
+        generateTaskFile(filename, lines, uniqueDescriptions);
+        size_t baselineKb = peakResidentKb();
+
+        size_t before = heapAllocationsSoFar();
+        auto start = Clock::now();
+        Task::loadTasksFromFile(filename);
+        double ms = elapsedMs(start);
+        size_t allocations = heapAllocationsSoFar() - before;
+        report("text load", lines, ms);
+        std::cout << "heap allocations: " << allocations << "\n"
+            << "peak RSS: " << peakResidentKb() / 1024 << " MB (before load: "
+            << baselineKb / 1024 << " MB)\n";
+        std::remove(filename.c_str());
+    }
+
+    /*------------------------- BENCHMARK SUITE ---------------------------*/
+
+    // Only mt19937's raw output is fixed by the standard (the std::
+    // distributions differ between library implementations), so the
+    // suite's generator draws from it directly and writes the same file
+    // on every platform for a given seed.
+    class SuiteRandom {
+    public:
+        explicit SuiteRandom(uint32_t seed) : rng(seed) {}
+        uint32_t below(uint32_t n) { return static_cast<uint32_t>(rng() % n); }
+        // Small values far more likely than large ones.
+        uint32_t skewed(uint32_t n) { return std::min({ below(n), below(n), below(n) }); }
+
+    private:
+        std::mt19937 rng;
+    };
+
+    // Most frequent first; skewed() picks favour the front, as in real lists.
+    const char* const suiteWords[] = {
+        "call", "email", "review", "fix", "buy", "send", "update", "meeting", "report", "team",
+        "client", "invoice", "bug", "release", "plan", "order", "book", "pay", "draft", "check",
+        "doctor", "groceries", "budget", "slides", "backup", "renew", "schedule", "follow-up",
+        "project", "weekly", "quarterly", "notes", "insurance", "tickets", "car", "garden",
+        "dentist", "tax", "return", "migration", "onboarding", "contract", "renewal", "design",
+    };
+    constexpr time_t suiteToday = 1735732800;  // 2025-01-01 12:00 UTC
+
+    // Descriptions of 2-8 common words (about 15-60 characters; one in 50
+    // is a long note, one in 4 carries a ticket number), priorities
+    // weighted towards Medium, a third completed, and due dates clustered
+    // within three months of suiteToday with completed tasks mostly
+    // behind it and one in 20 a year out.
+    void generateRealisticTaskFile(const std::string& filename, size_t lines, uint32_t seed = 2025) {
+        std::ofstream out(filename, std::ios::binary);
+        SuiteRandom random(seed);
+        const uint32_t wordCount = static_cast<uint32_t>(std::size(suiteWords));
+        std::string desc;
+        for (size_t i = 0; i < lines; ++i) {
+            desc.clear();
+            uint32_t words = 2 + random.below(4) + random.below(3);
+            if (random.below(50) == 0) words += 10 + random.below(20);
+            for (uint32_t w = 0; w < words; ++w) {
+                if (w > 0) desc += ' ';
+                desc += suiteWords[random.skewed(wordCount)];
+            }
+            if (random.below(4) == 0) desc += " #" + std::to_string(100 + random.below(9900));
+            desc[0] = static_cast<char>(desc[0] - 'a' + 'A');
+
+            uint32_t roll = random.below(100);
+            int prio = roll < 5 ? HIGHEST : roll < 25 ? HIGH : roll < 70 ? MEDIUM : roll < 90 ? LOW : LOWEST;
+            bool completed = random.below(100) < 35;
+            long long days = static_cast<long long>(random.below(61) + random.below(61) + random.below(61)) - 90;
+            if (completed) days -= 30;
+            if (random.below(20) == 0) days += 365;
+            long long seconds = static_cast<long long>(random.below(86400)) - 43200;
+            out << desc << '|' << prio << ' ' << (completed ? 1 : 0) << ' '
+                << (static_cast<long long>(suiteToday) + days * 86400 + seconds) << '\n';
+        }
+    }
+
+    std::string compilerName() {
+#if defined(_MSC_VER)
+        return "msvc " + std::to_string(_MSC_FULL_VER);
+#elif defined(__VERSION__)
+        return __VERSION__;
+#else
+        return "unknown";
+#endif
+    }
+
+    // One result: a table row on stdout and one JSON object per line in
+    // `json`, the form `compare` reads back.
+    void suiteResult(std::ostream& json, const std::string& op, size_t tasks, size_t ops, double ms) {
+        report(op + " (" + std::to_string(tasks) + ")", ops, ms);
+        json << std::fixed << std::setprecision(3)
+            << "{\"op\":\"" << op << "\",\"tasks\":" << tasks << ",\"ops\":" << ops
+            << ",\"ms\":" << ms << ",\"ns_per_op\":" << (ms * 1e6 / ops)
+            << ",\"ops_per_sec\":" << (ops / (ms / 1000.0))
+            << ",\"peak_rss_kb\":" << peakResidentKb() << "}\n";
+    }
+
+    struct SuiteTiming {
+        std::string op;
+        size_t ops;
+        double ms;
+    };
+
+    // Every public operation the menu drives, on a fresh list of `tasks`
+    // generated tasks; appends one timing per operation to `timings`.
+    // Output of the display functions is timed but discarded. Each sort is
+    // the first after a load, so it includes building the sorted indexes
+    // (later sorts only switch the order). Edits run after the reads, so
+    // they also pay for keeping those indexes up to date.
+    void runSuiteRound(size_t tasks, const std::string& filename, std::vector<SuiteTiming>& timings) {
+        const std::string saved = "bench_suite_saved.txt";
+        TaskList list;
+        NullBuffer discard;
+        std::streambuf* console = std::cout.rdbuf();
+        auto timed = [&](const std::string& op, size_t ops, auto&& body) {
+            std::cout.rdbuf(&discard);
+            auto start = Clock::now();
+            body();
+            double ms = elapsedMs(start);
+            std::cout.rdbuf(console);
+            timings.push_back({ op, ops, ms });
+        };
+
+        timed("loadTasksFromFile", tasks, [&]() { list.loadTasksFromFile(filename); });
+        timed("sortTasksByPriority", 1, [&]() { list.sortTasksByPriority(); });
+        list.loadTasksFromFile(filename);
+        timed("sortTasksByDueDate", 1, [&]() { list.sortTasksByDueDate(); });
+        timed("filterTasksByStatus", 2, [&]() {
+            list.filterTasksByStatus(true);
+            list.filterTasksByStatus(false);
+        });
+        const size_t polls = 1000;
+        timed("displayCompletionPercentage", polls, [&]() {
+            for (size_t i = 0; i < polls; ++i) list.displayCompletionPercentage();
+        });
+        timed("saveTasksToFile", tasks, [&]() { list.saveTasksToFile(saved); });
+
+        // Edit arguments are drawn up front so only the calls are timed.
+        const size_t edits = std::min<size_t>(tasks, 100000);
+        SuiteRandom random(static_cast<uint32_t>(tasks));
+        std::vector<int> updateIds(edits);
+        for (int& id : updateIds) id = 1 + static_cast<int>(random.below(static_cast<uint32_t>(tasks)));
+        std::vector<int> deleteIds(tasks);
+        for (size_t i = 0; i < tasks; ++i) deleteIds[i] = static_cast<int>(i + 1);
+        for (size_t i = 0; i < edits; ++i) {
+            std::swap(deleteIds[i], deleteIds[i + random.below(static_cast<uint32_t>(tasks - i))]);
+        }
+        deleteIds.resize(edits);
+
+        timed("addTask", edits, [&]() {
+            for (size_t i = 0; i < edits; ++i) {
+                list.addTask("Suite task #" + std::to_string(i), static_cast<Priority>(HIGHEST + i % 5),
+                    suiteToday + static_cast<time_t>(i % 180) * 86400);
+            }
+        });
+        timed("updateTask", edits, [&]() {
+            for (size_t i = 0; i < edits; ++i) {
+                switch (i % 3) {
+                case 0: list.updateTask(updateIds[i], {}, {}, i % 2 == 0, {}); break;
+                case 1: list.updateTask(updateIds[i], {}, static_cast<Priority>(HIGHEST + i % 5), {}, {}); break;
+                default: list.updateTask(updateIds[i], "Edited task " + std::to_string(i), {}, {}, {}); break;
+                }
+            }
+        });
+        timed("deleteTask", edits, [&]() {
+            for (int id : deleteIds) list.deleteTask(id);
+        });
+        std::remove(saved.c_str());
+    }
+
+    // Below a million tasks single runs are short enough to be noisy, so
+    // each operation reports its best of five rounds.
+    void runSuiteSize(size_t tasks, std::ostream& json) {
+        std::cout << "\n-- suite: " << tasks << " tasks --\n";
+        const std::string filename = "bench_suite_tasks.txt";
+        generateRealisticTaskFile(filename, tasks);
+        std::vector<SuiteTiming> best;
+        for (int round = 0, rounds = tasks < 1000000 ? 5 : 1; round < rounds; ++round) {
+            std::vector<SuiteTiming> timings;
+            runSuiteRound(tasks, filename, timings);
+            if (best.empty()) best = timings;
+            for (size_t i = 0; i < best.size(); ++i) best[i].ms = std::min(best[i].ms, timings[i].ms);
+        }
+        for (const SuiteTiming& timing : best) suiteResult(json, timing.op, tasks, timing.ops, timing.ms);
+        std::remove(filename.c_str());
+    }
+
+    // Sizes 1k, 10k, ... up to maxTasks (10M at most), results appended
+    // to `outFile` as JSON lines after a line describing the build.
+    void runSuite(size_t maxTasks, const std::string& outFile) {
+        std::ofstream json(outFile, std::ios::binary);
+        if (!json.is_open()) {
+            std::cerr << "Error: Unable to open " << outFile << ".\n";
+            return;
+        }
+#ifdef NDEBUG
+        const char* build = "release";
+#else
+        const char* build = "debug";
+#endif
+        json << "{\"suite\":\"todo\",\"format\":1,\"compiler\":\"" << compilerName()
+            << "\",\"build\":\"" << build << "\",\"hardware_threads\":"
+            << std::thread::hardware_concurrency() << "}\n";
+        for (size_t tasks = 1000; tasks <= std::min<size_t>(maxTasks, 10000000); tasks *= 10) {
+            runSuiteSize(tasks, json);
+        }
+        std::cout << "\nresults written to " << outFile << "\n";
+    }
+
+    // Value of `key` in one line written by suiteResult; empty if absent.
+    std::string suiteField(const std::string& line, const std::string& key) {
+        std::string tag = "\"" + key + "\":";
+        size_t pos = line.find(tag);
+        if (pos == std::string::npos) return {};
+        pos += tag.size();
+        if (pos < line.size() && line[pos] == '"') {
+            size_t end = line.find('"', pos + 1);
+            return line.substr(pos + 1, end - pos - 1);
+        }
+        return line.substr(pos, line.find_first_of(",}", pos) - pos);
+    }
+
+    std::unordered_map<std::string, double> readSuiteResults(const std::string& filename) {
+        std::unordered_map<std::string, double> nsPerOp;  // "op@tasks" -> ns/op
+        std::ifstream in(filename);
+        if (!in.is_open()) std::cerr << "Error: Unable to open " << filename << ".\n";
+        std::string line;
+        while (std::getline(in, line)) {
+            std::string op = suiteField(line, "op");
+            if (op.empty()) continue;
+            nsPerOp[op + "@" + suiteField(line, "tasks")] = std::strtod(suiteField(line, "ns_per_op").c_str(), nullptr);
+        }
+        return nsPerOp;
+    }
+
+    // ns/op of every result in `candidate` against the same operation and
+    // size in `baseline`. Returns the number of results slower by more
+    // than thresholdPercent.
+    size_t compareSuiteResults(const std::string& baseline, const std::string& candidate, double thresholdPercent) {
+        std::unordered_map<std::string, double> before = readSuiteResults(baseline);
+        std::unordered_map<std::string, double> after = readSuiteResults(candidate);
+        std::vector<std::string> keys;
+        for (auto& entry : after) {
+            if (before.count(entry.first)) keys.push_back(entry.first);
+        }
+        std::sort(keys.begin(), keys.end());
+
+        size_t regressions = 0;
+        std::cout << std::left << std::setw(44) << "operation@tasks" << std::right
+            << std::setw(14) << "before ns/op" << std::setw(14) << "after ns/op" << std::setw(10) << "change\n";
+        for (const std::string& key : keys) {
+            double change = before[key] > 0 ? (after[key] / before[key] - 1.0) * 100.0 : 0.0;
+            bool slower = change > thresholdPercent;
+            regressions += slower;
+            std::cout << std::left << std::setw(44) << key << std::right << std::fixed << std::setprecision(1)
+                << std::setw(14) << before[key] << std::setw(14) << after[key]
+                << std::setw(9) << std::showpos << change << std::noshowpos << "%"
+                << (slower ? "  REGRESSION" : "") << "\n";
+        }
+        std::cout << regressions << " of " << keys.size() << " results slower by more than "
+            << thresholdPercent << "%\n";
+        return regressions;
+    }
+
+    /*------------------------ SERVER LOAD GENERATOR -----------------------*/
+
+#ifdef __linux__
+    // A connected socket, or -1.
+    int connectToServer(const std::string& socketPath) {
+        sockaddr_un address{};
+        if (socketPath.size() >= sizeof(address.sun_path)) return -1;
+        address.sun_family = AF_UNIX;
+        std::copy(socketPath.begin(), socketPath.end(), address.sun_path);
+        int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0 && connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            close(fd);
+            fd = -1;
+        }
+        return fd;
+    }
+
+    struct ServerLoadClient {
+        std::vector<double> latenciesUs;
+        size_t errors = 0;
+    };
+
+    // One client: keeps `pipeline` requests in flight (sent in one write)
+    // and times each from its window's send to its own reply. The mix is
+    // 40% get, 20% add, 20% priority update, 10% complete, 10% count.
+    void runServerLoadClient(const std::string& socketPath, size_t requests, size_t pipeline,
+        int maxId, uint32_t seed, ServerLoadClient& result) {
+        int fd = connectToServer(socketPath);
+        if (fd < 0) return;
+        result.latenciesUs.reserve(requests);
+
+        SuiteRandom random(seed);
+        std::string window;
+        std::string received;
+        char buffer[64 * 1024];
+        for (size_t done = 0; done < requests;) {
+            size_t count = std::min(pipeline, requests - done);
+            window.clear();
+            for (size_t i = 0; i < count; ++i) {
+                std::string id = std::to_string(1 + random.below(static_cast<uint32_t>(maxId)));
+                uint32_t pick = random.below(10);
+                if (pick < 4) window += "get " + id + "\n";
+                else if (pick < 6) window += "add 3 2026-06-01 load generator task\n";
+                else if (pick < 8) window += "update " + id + " priority " + std::to_string(1 + random.below(5)) + "\n";
+                else if (pick < 9) window += "complete " + id + "\n";
+                else window += "count\n";
+            }
+            auto sentAt = Clock::now();
+            for (size_t offset = 0; offset < window.size();) {
+                ssize_t sent = send(fd, window.data() + offset, window.size() - offset, MSG_NOSIGNAL);
+                if (sent <= 0) {
+                    close(fd);
+                    return;
+                }
+                offset += static_cast<size_t>(sent);
+            }
+            for (size_t replies = 0; replies < count;) {
+                size_t end = received.find('\n');
+                if (end == std::string::npos) {
+                    ssize_t got = recv(fd, buffer, sizeof(buffer), 0);
+                    if (got <= 0) {
+                        close(fd);
+                        return;
+                    }
+                    received.append(buffer, static_cast<size_t>(got));
+                    continue;
+                }
+                result.latenciesUs.push_back(elapsedMs(sentAt) * 1000.0);
+                if (received.compare(0, 3, "ok ") != 0 && received.compare(0, 3, "ok\n") != 0) ++result.errors;
+                received.erase(0, end + 1);
+                ++replies;
+            }
+            done += count;
+        }
+        close(fd);
+    }
+
+    // Drives a running `todo --serve` from `clients` threads and reports
+    // throughput and the latency distribution over all requests.
+    void benchServer(const std::string& socketPath, size_t clients, size_t requests, size_t pipeline) {
+        std::cout << "\n-- server: " << clients << " clients x " << requests << " requests, pipeline "
+            << pipeline << " --\n";
+        pipeline = std::max<size_t>(pipeline, 1);
+
+        // Request IDs are drawn from 1 up to the server's task count.
+        int fd = connectToServer(socketPath);
+        char reply[128] = {};
+        bool counted = fd >= 0 && send(fd, "count\n", 6, MSG_NOSIGNAL) == 6
+            && recv(fd, reply, sizeof(reply) - 1, 0) > 3;
+        if (fd >= 0) close(fd);
+        if (!counted) {
+            std::cerr << "Error: No server on " << socketPath << " (start one with todo --serve).\n";
+            return;
+        }
+        int maxId = std::max(1, std::atoi(reply + 3));
+
+        std::vector<ServerLoadClient> results(clients);
+        std::vector<std::thread> threads;
+        auto start = Clock::now();
+        for (size_t i = 0; i < clients; ++i) {
+            threads.emplace_back(runServerLoadClient, socketPath, requests, pipeline, maxId,
+                static_cast<uint32_t>(i + 1), std::ref(results[i]));
+        }
+        for (std::thread& thread : threads) thread.join();
+        double ms = elapsedMs(start);
+
+        std::vector<double> latencies;
+        size_t errors = 0;
+        for (const ServerLoadClient& result : results) {
+            latencies.insert(latencies.end(), result.latenciesUs.begin(), result.latenciesUs.end());
+            errors += result.errors;
+        }
+        if (latencies.empty()) {
+            std::cerr << "Error: No replies from " << socketPath << ".\n";
+            return;
+        }
+        std::sort(latencies.begin(), latencies.end());
+        auto percentile = [&latencies](double fraction) {
+            return latencies[std::min(latencies.size() - 1, static_cast<size_t>(fraction * latencies.size()))];
+        };
+        report("requests", latencies.size(), ms);
+        std::cout << std::fixed << std::setprecision(1)
+            << "  latency us: p50 " << percentile(0.50) << ", p90 " << percentile(0.90)
+            << ", p99 " << percentile(0.99) << ", p99.9 " << percentile(0.999)
+            << ", max " << latencies.back() << "\n"
+            << "  " << std::setprecision(0) << latencies.size() / (ms / 1000.0) << " requests/s, "
+            << errors << " error replies\n";
+    }
+#endif
+
+} // end anonymous namespace
+
+// Usage: benchmark [index [tasks] [ops] | load [maxLines] | parallel [lines]
+//                   | sort [tasks] | sortfilter [maxTasks] | query [tasks]
+//                   | search [tasks] | due [tasks] | stats [tasks] [polls]
+//                   | concurrent [tasks] [batches] | save [tasks] [saves]
+//                   | autosave [tasks] [edits] | reminders [tasks]
+//                   | cursor [tasks] | scan [tasks] [scans] | render [rows]
+//                   | batch [commands] | lists [count] [tasksPerList]
+//                   | memory [lines] [unique]]
+//        benchmark suite [maxTasks] [results.jsonl]
+//        benchmark compare <baseline.jsonl> <candidate.jsonl> [thresholdPercent]
+//        benchmark generate <lines> <file> [seed]
+//        benchmark server <socket> [clients] [requestsPerClient] [pipeline]
+// "memory" measures peak RSS and is not part of "all". "suite" times the
+// public operations at 1k, 10k, ... tasks and writes JSON lines (ns/op,
+// ops/s, peak RSS); "compare" diffs two such files and exits non-zero on
+// a regression. "server" is a load generator for a running todo --serve
+// (Linux only). Besides benchmark.vcxproj, this builds on Linux with
+//   g++ -std=c++17 -O2 -DNDEBUG -pthread benchmark.cpp mylibrary.cpp -o benchmark
+int main(int argc, char* argv[]) {
+    std::string which = argc > 1 ? argv[1] : "all";
+    auto arg = [&](int i, size_t fallback) {
+        return argc > i ? static_cast<size_t>(std::strtoull(argv[i], nullptr, 10)) : fallback;
+    };
+
+    if (which == "suite") {
+        runSuite(arg(2, 1000000), argc > 3 ? argv[3] : "bench_suite.jsonl");
+        return 0;
+    }
+    if (which == "compare") {
+        if (argc < 4) {
+            std::cerr << "Usage: " << argv[0] << " compare <baseline.jsonl> <candidate.jsonl> [thresholdPercent]\n";
+            return 2;
+        }
+        double threshold = argc > 4 ? std::strtod(argv[4], nullptr) : 10.0;
+        return compareSuiteResults(argv[2], argv[3], threshold) == 0 ? 0 : 1;
+    }
+    if (which == "generate") {
+        if (argc < 4) {
+            std::cerr << "Usage: " << argv[0] << " generate <lines> <file> [seed]\n";
+            return 2;
+        }
+        generateRealisticTaskFile(argv[3], arg(2, 0), static_cast<uint32_t>(arg(4, 2025)));
+        return 0;
+    }
+
+    if (which == "server") {
+#ifdef __linux__
+        if (argc < 3) {
+            std::cerr << "Usage: " << argv[0] << " server <socket> [clients] [requestsPerClient] [pipeline]\n";
+            return 2;
+        }
+        benchServer(argv[2], arg(3, 8), arg(4, 100000), arg(5, 16));
+        return 0;
+#else
+        std::cerr << "Error: The server load generator needs Linux.\n";
+        return 2;
+#endif
+    }
+
+    if (which == "index" || which == "all") {
+        benchIdLookup(arg(2, 100000), arg(3, 10000));
+    }
+    if (which == "load" || which == "all") {
+        benchLoad(arg(2, 1000000));
+    }
+    if (which == "parallel" || which == "all") {
+        benchParallelLoad(arg(2, 5000000));
+    }
+    if (which == "sort" || which == "all") {
+        benchSort(arg(2, 1000000));
+    }
+    if (which == "sortfilter" || which == "all") {
+        benchSortFilter(arg(2, 10000000));
+    }
+    if (which == "query" || which == "all") {
+        benchQuery(arg(2, 5000000));
+    }
+    if (which == "search" || which == "all") {
+        benchSearch(arg(2, 2000000));
+    }
+    if (which == "due" || which == "all") {
+        benchDue(arg(2, 2000000));
+    }
+    if (which == "stats" || which == "all") {
+        benchStats(arg(2, 1000000), arg(3, 1000));
+    }
+    if (which == "concurrent" || which == "all") {
+        benchConcurrent(arg(2, 100000), arg(3, 20000));
+    }
+    if (which == "save" || which == "all") {
+        benchSave(arg(2, 100000), arg(3, 50));
+    }
+    if (which == "autosave" || which == "all") {
+        benchAutosave(arg(2, 1000000), arg(3, 200000));
+    }
+    if (which == "reminders" || which == "all") {
+        benchReminders(arg(2, 1000000));
+    }
+    if (which == "cursor" || which == "all") {
+        benchCursor(arg(2, 1000000));
+    }
+    if (which == "scan" || which == "all") {
+        benchScan(arg(2, 1000000), arg(3, 100));
+    }
+    if (which == "render" || which == "all") {
+        benchRender(arg(2, 1000000));
+    }
+    if (which == "batch" || which == "all") {
+        benchBatch(arg(2, 1000000));
+    }
+    if (which == "lists" || which == "all") {
+        benchLists(arg(2, 10000), arg(3, 10));
+    }
+    if (which == "memory") {
+        benchMemory(arg(2, 5000000), arg(3, 0) != 0);
+    }
+    return 0;
+}
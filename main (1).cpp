@@ -1,15 +1,151 @@
 #include "mylibrary.h"
+#include <fstream>
 #include <iostream>
 #include <limits>
+#include <string>
+#include <vector>
 
-int main() {
+// Shows a cursor's rows a page at a time until the user quits. Returns
+// false if the view is empty.
+static bool browsePages(MyLibrary::TaskCursor cursor) {
+    std::vector<MyLibrary::TaskRow> page = cursor.next();
+    if (page.empty()) {
+        return false;
+    }
+    while (true) {
+        MyLibrary::displayRows(page);
+        bool hasPrevious = cursor.hasPrevious();
+        bool hasNext = cursor.hasNext();
+        if (!hasPrevious && !hasNext) {
+            return true;  // everything fit on one page
+        }
+        std::cout << (hasNext ? "[n]ext, " : "") << (hasPrevious ? "[p]revious, " : "")
+            << "[g]o to ID, [q]uit: ";
+        char command;
+        std::cin >> command;
+        if (!std::cin) {
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            return true;
+        }
+        if (command == 'n' || command == 'N') {
+            if (hasNext) page = cursor.next();
+        }
+        else if (command == 'p' || command == 'P') {
+            if (hasPrevious) page = cursor.previous();
+        }
+        else if (command == 'g' || command == 'G') {
+            std::cout << "Enter task ID: ";
+            int id;
+            std::cin >> id;
+            if (!std::cin) {
+                std::cin.clear();
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                std::cerr << "Invalid ID.\n";
+                continue;
+            }
+            std::vector<MyLibrary::TaskRow> found = cursor.seek(id);
+            if (found.empty()) {
+                std::cerr << "Task " << id << " is not in this list.\n";
+                continue;
+            }
+            page = found;
+        }
+        else if (command == 'q' || command == 'Q') {
+            return true;
+        }
+        else {
+            std::cerr << "Invalid choice.\n";
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
     using namespace MyLibrary;  // Pull in our library functions/classes
 
+    // Converter mode: todo --convert <input> <output>
+    // Formats follow the file extensions (".bin" = binary snapshot), so this
+    // migrates tasks.txt to a snapshot and back.
+    if (argc > 1 && std::string(argv[1]) == "--convert") {
+        if (argc != 4) {
+            std::cerr << "Usage: " << argv[0] << " --convert <input> <output>\n";
+            return 1;
+        }
+        const std::string input = argv[2];
+        if (!std::ifstream(input)) {
+            std::cerr << "Error: Unable to open " << input << ".\n";
+            return 1;
+        }
+        // Edits still in the input's journal belong in the output too;
+        // the input and its journal are only read.
+        Task::loadJournaledTasks(input);
+        Task::saveTasksToFile(argv[3]);
+        std::cout << "Converted " << input << " to " << argv[3] << ".\n";
+        return 0;
+    }
+
     const std::string filename = "tasks.txt";
-    Task::loadTasksFromFile(filename);
+
+    // Batch mode: todo --batch [commands-file]   (stdin without a file or with "-")
+    // Runs the commands against tasks.txt without prompts; see runBatch.
+    if (argc > 1 && std::string(argv[1]) == "--batch") {
+        if (argc > 3) {
+            std::cerr << "Usage: " << argv[0] << " --batch [commands-file]\n";
+            return 1;
+        }
+        std::ios::sync_with_stdio(false);
+        size_t failed = 0;
+        if (argc == 3 && std::string(argv[2]) != "-") {
+            std::ifstream commands(argv[2]);
+            if (!commands.is_open()) {
+                std::cerr << "Error: Unable to open " << argv[2] << ".\n";
+                return 1;
+            }
+            failed = runBatch(commands, filename);
+        }
+        else {
+            failed = runBatch(std::cin, filename);
+        }
+        return failed == 0 ? 0 : 1;
+    }
+
+    // Server mode: todo --serve [socket-path]   (default todo.sock)
+    // Keeps tasks.txt loaded and answers clients until SIGINT/SIGTERM; see runServer.
+    if (argc > 1 && std::string(argv[1]) == "--serve") {
+        if (argc > 3) {
+            std::cerr << "Usage: " << argv[0] << " --serve [socket-path]\n";
+            return 1;
+        }
+        return runServer(argc == 3 ? argv[2] : "todo.sock", filename);
+    }
+
+    // Every add/edit/delete is appended to tasks.txt.wal; the journal is
+    // replayed on startup and folded back into tasks.txt in the background
+    // and on exit. With --autosave, tasks.txt is instead rewritten by a
+    // background worker shortly after changes.
+    if (argc > 1 && std::string(argv[1]) == "--autosave") {
+        // Edits still in the journal from a journaled session go into
+        // tasks.txt first; autosave rewrites the file without it.
+        Task::openJournal(filename);
+        Task::closeJournal(true);
+        Task::startAutosave(filename);
+    }
+    else {
+        Task::openJournal(filename);
+    }
+
+    // Reminders for tasks that come due while the program runs, shown
+    // before the menu.
+    Task::startReminders([](const TaskRow& task) {
+        std::cout << "Reminder: Task " << task.id << " \"" << task.description << "\" is now due.\n";
+    });
+
+    // Displays and filters page through this view; the sort entries set its order.
+    TaskQuery view;
 
     bool running = true;
     while (running) {
+        Task::pollReminders();
         std::cout << "\n========== TO-DO LIST MANAGER ==========\n"
             << "1. Add Task\n"
             << "2. Edit Task\n"
@@ -21,6 +157,11 @@ int main() {
             << "8. Sort Tasks by Due Date\n"
             << "9. Display Completion Percentage\n"
             << "10. Save Tasks\n"
+            << "11. Filter by Priority\n"
+            << "12. Search Tasks\n"
+            << "13. Overdue / Due Soon\n"
+            << "14. Task Statistics\n"
+            << "15. Performance Counters\n"
             << "0. Exit\n"
             << "========================================\n"
             << "Enter your choice: ";
@@ -46,8 +187,9 @@ int main() {
             Priority prio = promptForPriority();
             time_t due = promptForDueDate();
 
-            Task::addTask(desc, prio, due);
-            std::cout << "Task added successfully.\n";
+            if (Task::addTask(desc, prio, due) != 0) {
+                std::cout << "Task added successfully.\n";
+            }
             break;
         }
         case 2: { // Edit Task
@@ -144,9 +286,12 @@ int main() {
             std::cout << "Task marked as completed (if ID was valid).\n";
             break;
         }
-        case 5:
-            Task::displayTasks();
+        case 5: { // Display All Tasks, a page at a time
+            if (!browsePages(Task::openCursor(view))) {
+                std::cout << "No tasks available.\n";
+            }
             break;
+        }
         case 6: { // Filter by Status
             std::cout << "Filter tasks by status:\n"
                 << "1. Completed\n"
@@ -160,14 +305,15 @@ int main() {
                 std::cerr << "Invalid choice.\n";
                 break;
             }
-            if (statusChoice == 1) {
-                Task::filterTasksByStatus(true);
-            }
-            else if (statusChoice == 2) {
-                Task::filterTasksByStatus(false);
-            }
-            else {
+            if (statusChoice != 1 && statusChoice != 2) {
                 std::cerr << "Invalid choice.\n";
+                break;
+            }
+            TaskQuery filtered = view;
+            filtered.completed = statusChoice == 1;
+            if (!browsePages(Task::openCursor(filtered))) {
+                std::cout << "No tasks found with status: "
+                    << (statusChoice == 1 ? "Completed" : "Pending") << std::endl;
             }
             break;
         }
@@ -192,7 +338,10 @@ int main() {
             }
             else {
                 std::cerr << "Invalid choice.\n";
+                break;
             }
+            view.orderBy = TaskQuery::Order::Priority;
+            view.ascending = sortChoice == 1;
             break;
         }
         case 8: { // Sort by Due Date
@@ -216,16 +365,42 @@ int main() {
             }
             else {
                 std::cerr << "Invalid choice.\n";
+                break;
             }
+            view.orderBy = TaskQuery::Order::DueDate;
+            view.ascending = sortChoice == 1;
             break;
         }
         case 9:
             Task::displayCompletionPercentage();
             break;
         case 10:
-            Task::saveTasksToFile(filename);
+            Task::syncJournal();
+            Task::flushAutosave();
             std::cout << "Tasks saved to file.\n";
             break;
+        case 11: { // Filter by Priority
+            Priority prio = promptForPriority();
+            Task::filterTasksByPriority(prio);
+            break;
+        }
+        case 12: { // Search Tasks
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            std::cout << "Search for (words, OR between alternatives, * for prefix): ";
+            std::string query;
+            std::getline(std::cin, query);
+            Task::displaySearchResults(query);
+            break;
+        }
+        case 13: // Overdue / Due Soon
+            Task::displayDueSummary();
+            break;
+        case 14:
+            Task::displayStatistics();
+            break;
+        case 15:
+            displayInstrumentation();
+            break;
         case 0:
             running = false;
             break;
@@ -235,8 +410,16 @@ int main() {
         }
     }
 
-    // Optionally, auto-save before exiting.
-    // Task::saveTasksToFile(filename);
+    // Flush autosave, or fold the journal into tasks.txt; pending edits
+    // would otherwise wait for the next sync batch or compaction.
+    Task::stopReminders();
+    Task::stopAutosave();
+    Task::closeJournal();
+
+#if MYLIBRARY_INSTRUMENTATION
+    // Per-operation timings for this session, for finding slow paths.
+    saveInstrumentationJson("todo_stats.json");
+#endif
 
     std::cout << "Exiting program. Goodbye.\n";
     return 0;
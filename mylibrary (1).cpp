@@ -4,23 +4,326 @@
 #define _CRT_SECURE_NO_WARNINGS  // If you want to suppress MSVC localtime deprecation warnings
 #endif
 
+#include <atomic>
+#include <bitset>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+#if MYLIBRARY_INSTRUMENTATION
+
+/*------------------------ HEAP ALLOCATION COUNTS -----------------------*/
+
+// Every heap allocation in the program goes through here while the
+// instrumentation is compiled in. Each block carries its size in a header
+// that keeps malloc's alignment, so the bytes in use can be tracked.
+namespace
+{
+    std::atomic<uint64_t> heapAllocationCount{ 0 };
+    std::atomic<uint64_t> heapBytesInUse{ 0 };
+    // Allocation counter of the operation running on this thread, if any.
+    thread_local std::atomic<uint64_t>* operationAllocations = nullptr;
+    constexpr size_t allocationHeader = alignof(std::max_align_t);
+
+    void* countedAlloc(std::size_t size) {
+        heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+        heapBytesInUse.fetch_add(size, std::memory_order_relaxed);
+        if (operationAllocations) operationAllocations->fetch_add(1, std::memory_order_relaxed);
+        if (char* block = static_cast<char*>(std::malloc(size + allocationHeader))) {
+            *reinterpret_cast<std::size_t*>(block) = size;
+            return block + allocationHeader;
+        }
+        throw std::bad_alloc();
+    }
+
+    void countedFree(void* p) noexcept {
+        if (!p) return;
+        char* block = static_cast<char*>(p) - allocationHeader;
+        heapBytesInUse.fetch_sub(*reinterpret_cast<std::size_t*>(block), std::memory_order_relaxed);
+        std::free(block);
+    }
+}
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return countedAlloc(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return countedAlloc(size); } catch (...) { return nullptr; }
+}
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+
+#endif
+
 namespace MyLibrary
 {
-    /*--------------------- STATIC MEMBER DEFINITIONS ---------------------*/
-    int Task::nextId = 1;
-    std::vector<Task> Task::tasks;
+    /*--------------------------- INSTRUMENTATION -------------------------*/
+
+    namespace
+    {
+#if MYLIBRARY_INSTRUMENTATION
+        struct OperationCounters {
+            std::atomic<uint64_t> calls{ 0 };
+            std::atomic<uint64_t> totalNs{ 0 };
+            std::atomic<uint64_t> maxNs{ 0 };
+            std::atomic<uint64_t> allocations{ 0 };
+            std::atomic<uint64_t> bytesRead{ 0 };
+            std::atomic<uint64_t> bytesWritten{ 0 };
+            std::atomic<uint64_t> histogram[latencyBucketCount] = {};
+        };
+
+        OperationCounters operationCounters[static_cast<size_t>(Operation::Count)];
+        std::atomic<uint64_t> totalBytesRead{ 0 };
+        std::atomic<uint64_t> totalBytesWritten{ 0 };
+        thread_local OperationCounters* currentOperation = nullptr;
+
+        // Times one public call. Only the outermost timer on a thread
+        // records; nested calls are part of it.
+        class OperationTimer {
+        public:
+            explicit OperationTimer(Operation op) {
+                if (currentOperation) return;
+                counters = &operationCounters[static_cast<size_t>(op)];
+                currentOperation = counters;
+                operationAllocations = &counters->allocations;
+                start = std::chrono::steady_clock::now();
+            }
+
+            ~OperationTimer() {
+                if (!counters) return;
+                uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count());
+                size_t bucket = 0;
+                while (bucket + 1 < latencyBucketCount && (ns >> (bucket + 1)) != 0) ++bucket;
+                counters->calls.fetch_add(1, std::memory_order_relaxed);
+                counters->totalNs.fetch_add(ns, std::memory_order_relaxed);
+                counters->histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+                uint64_t seen = counters->maxNs.load(std::memory_order_relaxed);
+                while (ns > seen && !counters->maxNs.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {}
+                currentOperation = nullptr;
+                operationAllocations = nullptr;
+            }
+
+            OperationTimer(const OperationTimer&) = delete;
+            OperationTimer& operator=(const OperationTimer&) = delete;
+
+        private:
+            OperationCounters* counters = nullptr;
+            std::chrono::steady_clock::time_point start;
+        };
+
+        void countBytesRead(uint64_t bytes) {
+            totalBytesRead.fetch_add(bytes, std::memory_order_relaxed);
+            if (currentOperation) currentOperation->bytesRead.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        void countBytesWritten(uint64_t bytes) {
+            totalBytesWritten.fetch_add(bytes, std::memory_order_relaxed);
+            if (currentOperation) currentOperation->bytesWritten.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+#define MYLIBRARY_TIME_OPERATION(op) OperationTimer operationTimer(op)
+
+        // Upper bound of the bucket holding the given fraction of calls.
+        uint64_t histogramPercentile(const OperationStats& stats, double fraction) {
+            uint64_t target = static_cast<uint64_t>(static_cast<double>(stats.calls) * fraction + 0.999999);
+            uint64_t seen = 0;
+            for (size_t bucket = 0; bucket < latencyBucketCount; ++bucket) {
+                seen += stats.histogram[bucket];
+                if (seen >= target && seen != 0) return std::min(uint64_t(2) << bucket, stats.maxNs);
+            }
+            return stats.maxNs;
+        }
+#else
+        void countBytesRead(uint64_t) {}
+        void countBytesWritten(uint64_t) {}
+
+#define MYLIBRARY_TIME_OPERATION(op) ((void)0)
+#endif
+
+        std::string formatNs(uint64_t ns) {
+            std::ostringstream out;
+            out << std::fixed << std::setprecision(1);
+            if (ns < 1000) out << ns << "ns";
+            else if (ns < 1000000) out << ns / 1e3 << "us";
+            else if (ns < 1000000000) out << ns / 1e6 << "ms";
+            else out << ns / 1e9 << "s";
+            return out.str();
+        }
+    }
+
+    const char* operationName(Operation op) {
+        static const char* const names[] = {
+            "load", "save", "add", "update", "delete",
+            "sort_priority", "sort_due_date", "filter_status", "filter_priority", "display",
+        };
+        size_t index = static_cast<size_t>(op);
+        return index < std::size(names) ? names[index] : "unknown";
+    }
+
+    InstrumentationStats instrumentationStats() {
+        InstrumentationStats stats;
+#if MYLIBRARY_INSTRUMENTATION
+        stats.enabled = true;
+        for (size_t op = 0; op < static_cast<size_t>(Operation::Count); ++op) {
+            const OperationCounters& counters = operationCounters[op];
+            OperationStats& out = stats.operations[op];
+            out.totalNs = counters.totalNs.load(std::memory_order_relaxed);
+            out.maxNs = counters.maxNs.load(std::memory_order_relaxed);
+            out.allocations = counters.allocations.load(std::memory_order_relaxed);
+            out.bytesRead = counters.bytesRead.load(std::memory_order_relaxed);
+            out.bytesWritten = counters.bytesWritten.load(std::memory_order_relaxed);
+            // Calls from the histogram, so the percentiles agree with it.
+            for (size_t bucket = 0; bucket < latencyBucketCount; ++bucket) {
+                out.histogram[bucket] = counters.histogram[bucket].load(std::memory_order_relaxed);
+                out.calls += out.histogram[bucket];
+            }
+            out.p50Ns = histogramPercentile(out, 0.50);
+            out.p90Ns = histogramPercentile(out, 0.90);
+            out.p99Ns = histogramPercentile(out, 0.99);
+        }
+        stats.heapAllocations = heapAllocationCount.load(std::memory_order_relaxed);
+        stats.heapBytesInUse = heapBytesInUse.load(std::memory_order_relaxed);
+        stats.bytesRead = totalBytesRead.load(std::memory_order_relaxed);
+        stats.bytesWritten = totalBytesWritten.load(std::memory_order_relaxed);
+#endif
+        return stats;
+    }
+
+    void resetInstrumentation() {
+#if MYLIBRARY_INSTRUMENTATION
+        for (OperationCounters& counters : operationCounters) {
+            counters.calls = 0;
+            counters.totalNs = 0;
+            counters.maxNs = 0;
+            counters.allocations = 0;
+            counters.bytesRead = 0;
+            counters.bytesWritten = 0;
+            for (auto& bucket : counters.histogram) bucket = 0;
+        }
+        totalBytesRead = 0;
+        totalBytesWritten = 0;
+#endif
+    }
+
+    void displayInstrumentation() {
+        InstrumentationStats stats = instrumentationStats();
+        if (!stats.enabled) {
+            std::cout << "Instrumentation is compiled out (MYLIBRARY_INSTRUMENTATION=0).\n";
+            return;
+        }
+        std::cout << std::left << std::setw(16) << "Operation" << std::right
+            << std::setw(9) << "Calls" << std::setw(10) << "Mean" << std::setw(10) << "p50"
+            << std::setw(10) << "p99" << std::setw(10) << "Max" << std::setw(10) << "Allocs"
+            << std::setw(12) << "Read" << std::setw(12) << "Written" << "\n";
+        for (size_t op = 0; op < static_cast<size_t>(Operation::Count); ++op) {
+            const OperationStats& entry = stats.operations[op];
+            if (entry.calls == 0) continue;
+            std::cout << std::left << std::setw(16) << operationName(static_cast<Operation>(op)) << std::right
+                << std::setw(9) << entry.calls << std::setw(10) << formatNs(entry.totalNs / entry.calls)
+                << std::setw(10) << formatNs(entry.p50Ns) << std::setw(10) << formatNs(entry.p99Ns)
+                << std::setw(10) << formatNs(entry.maxNs) << std::setw(10) << entry.allocations
+                << std::setw(12) << entry.bytesRead << std::setw(12) << entry.bytesWritten << "\n";
+        }
+        std::cout << "Heap: " << stats.heapAllocations << " allocations, " << stats.heapBytesInUse
+            << " bytes in use. I/O: " << stats.bytesRead << " bytes read, "
+            << stats.bytesWritten << " bytes written.\n";
+    }
+
+    // One object: totals, then per operation its counters and the
+    // non-empty histogram buckets as [lower bound in ns, calls] pairs.
+    bool saveInstrumentationJson(const std::string& filename) {
+        InstrumentationStats stats = instrumentationStats();
+        std::ofstream out(filename);
+        if (!out.is_open()) {
+            std::cerr << "Error: Unable to open " << filename << " for writing.\n";
+            return false;
+        }
+        out << "{\"enabled\":" << (stats.enabled ? "true" : "false")
+            << ",\"heap_allocations\":" << stats.heapAllocations
+            << ",\"heap_bytes_in_use\":" << stats.heapBytesInUse
+            << ",\"bytes_read\":" << stats.bytesRead
+            << ",\"bytes_written\":" << stats.bytesWritten
+            << ",\"operations\":{";
+        for (size_t op = 0; op < static_cast<size_t>(Operation::Count); ++op) {
+            const OperationStats& entry = stats.operations[op];
+            out << (op ? "," : "") << "\n  \"" << operationName(static_cast<Operation>(op)) << "\":{"
+                << "\"calls\":" << entry.calls << ",\"total_ns\":" << entry.totalNs
+                << ",\"p50_ns\":" << entry.p50Ns << ",\"p90_ns\":" << entry.p90Ns
+                << ",\"p99_ns\":" << entry.p99Ns << ",\"max_ns\":" << entry.maxNs
+                << ",\"allocations\":" << entry.allocations
+                << ",\"bytes_read\":" << entry.bytesRead << ",\"bytes_written\":" << entry.bytesWritten
+                << ",\"histogram\":[";
+            bool first = true;
+            for (size_t bucket = 0; bucket < latencyBucketCount; ++bucket) {
+                if (entry.histogram[bucket] == 0) continue;
+                out << (first ? "" : ",") << "[" << (uint64_t(1) << bucket) << "," << entry.histogram[bucket] << "]";
+                first = false;
+            }
+            out << "]}";
+        }
+        out << "\n}}\n";
+        out.close();
+        return !out.fail();
+    }
 
     /*--------------------- FREE FUNCTION IMPLEMENTATIONS -----------------*/
 
-    std::string priorityToString(Priority prio) {
-        switch (prio) {
-        case HIGHEST: return "Highest";
-        case HIGH:    return "High";
-        case MEDIUM:  return "Medium";
-        case LOW:     return "Low";
-        case LOWEST:  return "Lowest";
-        default:      return "Unknown";
+    namespace
+    {
+        const char* const priorityNames[] = { "Unknown", "Highest", "High", "Medium", "Low", "Lowest" };
+
+        // Index into priorityNames and the per-priority counts.
+        size_t priorityBucket(int prio) {
+            return prio >= HIGHEST && prio <= LOWEST ? static_cast<size_t>(prio) : 0;
         }
+
+        const char* priorityName(int prio) {
+            return priorityNames[priorityBucket(prio)];
+        }
+    }
+
+    std::string priorityToString(Priority prio) {
+        return priorityName(prio);
     }
 
     std::optional<Priority> stringToPrioritySafe(const std::string& str) {
@@ -65,258 +368,4421 @@ namespace MyLibrary
                 continue;
             }
 
-            tm timeStruct = {};
-            timeStruct.tm_year = year - 1900; // years since 1900
-            timeStruct.tm_mon = month - 1;   // months since January
-            timeStruct.tm_mday = day;
-            timeStruct.tm_hour = 12;         // set to noon to avoid DST issues
-            timeStruct.tm_min = 0;
-            timeStruct.tm_sec = 0;
-
-            time_t due = mktime(&timeStruct);
-            if (due == -1) {
+            std::optional<time_t> due = makeDueDate(year, month, day);
+            if (!due) {
                 std::cerr << "Failed to parse that date. Please try again.\n";
                 continue;
             }
-            return due;
+            return *due;
         }
     }
 
-    /*-------------------- TASK CLASS IMPLEMENTATIONS ---------------------*/
+    std::optional<time_t> makeDueDate(int year, int month, int day) {
+        tm timeStruct = {};
+        timeStruct.tm_year = year - 1900; // years since 1900
+        timeStruct.tm_mon = month - 1;   // months since January
+        timeStruct.tm_mday = day;
+        timeStruct.tm_hour = 12;         // set to noon to avoid DST issues
+        timeStruct.tm_min = 0;
+        timeStruct.tm_sec = 0;
 
-    Task::Task(const std::string& desc, Priority prio, time_t due)
-        : id(nextId++), description(desc), priority(prio), completed(false), dueDate(due)
-    {}
+        time_t due = mktime(&timeStruct);
+        if (due == -1) {
+            return std::nullopt;
+        }
+        return due;
+    }
 
-    bool Task::validateTask(const std::string& desc, Priority prio) {
-        if (desc.empty()) {
-            std::cerr << "Error: Description cannot be empty.\n";
-            return false;
+    /*------------------------ FILE LOADING HELPERS ----------------------*/
+
+    namespace
+    {
+        // Read-only view of a whole file. An empty file maps to an empty
+        // (null) range rather than failing, since it is a valid task list.
+        class MappedFile {
+        public:
+            MappedFile() = default;
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+            ~MappedFile() { close(); }
+
+            bool open(const std::string& filename) {
+#ifdef _WIN32
+                file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                    OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+                if (file == INVALID_HANDLE_VALUE) return false;
+                LARGE_INTEGER fileSize{};
+                if (!GetFileSizeEx(file, &fileSize)) { close(); return false; }
+                length = static_cast<size_t>(fileSize.QuadPart);
+                if (length == 0) return true;
+                mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (!mapping) { close(); return false; }
+                view = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                if (!view) { close(); return false; }
+#else
+                fd = ::open(filename.c_str(), O_RDONLY);
+                if (fd < 0) return false;
+                struct stat st{};
+                if (fstat(fd, &st) != 0) { close(); return false; }
+                length = static_cast<size_t>(st.st_size);
+                if (length == 0) return true;
+                void* addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (addr == MAP_FAILED) { close(); return false; }
+                view = static_cast<const char*>(addr);
+                madvise(addr, length, MADV_SEQUENTIAL);
+#endif
+                countBytesRead(length);
+                return true;
+            }
+
+            void close() {
+#ifdef _WIN32
+                if (view) UnmapViewOfFile(view);
+                if (mapping) CloseHandle(mapping);
+                if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+                mapping = nullptr;
+                file = INVALID_HANDLE_VALUE;
+#else
+                if (view) munmap(const_cast<char*>(view), length);
+                if (fd >= 0) ::close(fd);
+                fd = -1;
+#endif
+                view = nullptr;
+                length = 0;
+            }
+
+            const char* begin() const { return view; }
+            const char* end() const { return view + length; }
+            size_t size() const { return length; }
+
+        private:
+#ifdef _WIN32
+            HANDLE file = INVALID_HANDLE_VALUE;
+            HANDLE mapping = nullptr;
+#else
+            int fd = -1;
+#endif
+            const char* view = nullptr;
+            size_t length = 0;
+        };
+
+        inline bool isStreamSpace(char c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
         }
-        if (prio < HIGHEST || prio > LOWEST) {
-            std::cerr << "Error: Priority must be between 1 and 5.\n";
-            return false;
+
+        // Calls visit(slot) for every set bit of the bitset whose words
+        // wordAt(firstWord..lastWord-1) returns; empty words are skipped whole.
+        template <typename WordFn, typename Visitor>
+        void forEachSetBit(size_t firstWord, size_t lastWord, WordFn&& wordAt, Visitor&& visit) {
+            for (size_t word = firstWord; word < lastWord; ++word) {
+                uint64_t bits = wordAt(word);
+                for (size_t slot = word * 64; bits != 0; ++slot, bits >>= 1) {
+                    if (bits & 1) visit(slot);
+                }
+            }
         }
-        return true;
-    }
 
-    void Task::loadTasksFromFile(const std::string& filename) {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            // If file not found, not necessarily an error; do nothing
-            return;
+        // Walks the entries [first, last) of a (key, id) index in key order,
+        // while visit(id) returns true. Equal keys always come out in
+        // ascending ID order, so descending views stay stable too. `first`
+        // must be the first entry of its key.
+        template <typename Key, typename Visitor>
+        void walkIndexRange(const std::set<std::pair<Key, int>>& index,
+            typename std::set<std::pair<Key, int>>::const_iterator first,
+            typename std::set<std::pair<Key, int>>::const_iterator last,
+            bool ascending, Visitor&& visit) {
+            if (ascending) {
+                for (auto it = first; it != last; ++it) {
+                    if (!visit(it->second)) return;
+                }
+                return;
+            }
+            auto keyEnd = last;
+            while (keyEnd != first) {
+                Key key = std::prev(keyEnd)->first;
+                auto keyBegin = index.lower_bound({ key, std::numeric_limits<int>::min() });
+                for (auto it = keyBegin; it != keyEnd; ++it) {
+                    if (!visit(it->second)) return;
+                }
+                keyEnd = keyBegin;
+            }
         }
 
-        tasks.clear();
-        while (true) {
-            if (!file.good() || file.peek() == EOF) break;
+        template <typename Key, typename Visitor>
+        void walkIndex(const std::set<std::pair<Key, int>>& index, bool ascending, Visitor&& visit) {
+            walkIndexRange(index, index.begin(), index.end(), ascending,
+                [&visit](int id) { visit(id); return true; });
+        }
+
+        // Optional trailing ID after the due date (absent in old files).
+        // Only blanks may separate it, so the next line is never consumed.
+        bool scanTrailingId(const char*& pos, const char* end, int& id) {
+            const char* cursor = pos;
+            while (cursor != end && (*cursor == ' ' || *cursor == '\t')) ++cursor;
+            auto result = std::from_chars(cursor, end, id);
+            if (result.ec != std::errc() || id <= 0) return false;
+            pos = result.ptr;
+            return true;
+        }
 
-            std::string desc;
-            getline(file, desc, '|');  // read description until '|'
-            if (!file.good()) break;
+        // Equivalent of `stream >> value` on the mapped bytes: skips leading
+        // whitespace, accepts an optional sign and fails on overflow. Like the
+        // stream version it also fails when the number runs into end-of-file,
+        // because the old reader treated the resulting eofbit as an error.
+        template <typename Int>
+        bool scanInteger(const char*& pos, const char* end, Int& value) {
+            while (pos != end && isStreamSpace(*pos)) ++pos;
+            if (pos != end && *pos == '+') {
+                ++pos;
+                if (pos == end || *pos < '0' || *pos > '9') return false;
+            }
+            auto result = std::from_chars(pos, end, value);
+            if (result.ec != std::errc() || result.ptr == end) return false;
+            pos = result.ptr;
+            return true;
+        }
 
-            int prioInt = 0;
-            int compInt = 0;
-            time_t due = 0;
+        // The text reader takes a description up to the next '|', so one
+        // holding '|' could not be read back. (Line breaks read back fine.)
+        bool fitsTextRecord(std::string_view desc) {
+            return desc.find('|') == std::string_view::npos;
+        }
 
-            file >> prioInt;
-            if (!file.good()) break;
+        // One record of a text task file. Descriptions point into the mapping.
+        struct TextRecord {
+            std::string_view desc;
+            int prio;
+            int completed;
+            time_t due;
+            int id;
+            bool valid;  // false: empty description or bad priority, skipped with a warning
+        };
 
-            file >> compInt;
-            if (!file.good()) break;
+        // Text files end with a "#nextId <n>" line so IDs of deleted tasks
+        // stay retired. It has no '|', so readers that predate it (the
+        // stream reader included) stop there. Returns where the records
+        // end: the start of that line, or `end` if there is none.
+        const char* findNextIdTrailer(const char* begin, const char* end, int64_t& savedNextId) {
+            static constexpr char tag[] = "#nextId ";
+            const char* last = end;
+            if (last != begin && last[-1] == '\n') --last;
+            if (last != begin && last[-1] == '\r') --last;
+            const char* lineStart = last;
+            while (lineStart != begin && lineStart[-1] != '\n') --lineStart;
+            const size_t tagLength = sizeof(tag) - 1;
+            if (static_cast<size_t>(last - lineStart) <= tagLength || memcmp(lineStart, tag, tagLength) != 0) {
+                return end;
+            }
+            int64_t value = 0;
+            auto result = std::from_chars(lineStart + tagLength, last, value);
+            if (result.ec != std::errc() || result.ptr != last) return end;
+            savedNextId = value;
+            return lineStart;
+        }
 
-            file >> due;
-            if (!file.good()) break;
+        // Parses records from `pos` until the next one would start at or
+        // after `limit`. A record's fields may run past `limit` (up to
+        // `end`), exactly as they would in a whole-file parse. Returns false
+        // if a malformed field stopped the parse, which ends the whole load.
+        // On return `pos` is just past the last complete record.
+        // Format: description|priority completed dueDate [id]
+        template <typename Visitor>
+        bool scanTextRecords(const char*& pos, const char* end, const char* limit, Visitor&& visit) {
+            while (pos < limit) {
+                const char* cursor = pos;
+                const char* bar = static_cast<const char*>(memchr(cursor, '|', end - cursor));
+                if (!bar) return false;
+                TextRecord record{};
+                record.desc = std::string_view(cursor, static_cast<size_t>(bar - cursor));
+                cursor = bar + 1;
 
-            file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                if (!scanInteger(cursor, end, record.prio)) return false;
+                if (!scanInteger(cursor, end, record.completed)) return false;
+                if (!scanInteger(cursor, end, record.due)) return false;
+                scanTrailingId(cursor, end, record.id);
 
-            if (desc.empty() || prioInt < HIGHEST || prioInt > LOWEST) {
-                std::cerr << "Skipping invalid task from file.\n";
-                continue;
+                const char* newline = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+                pos = newline ? newline + 1 : end;
+                record.valid = !record.desc.empty() && record.prio >= HIGHEST && record.prio <= LOWEST;
+                visit(record);
             }
+            return true;
+        }
+
+        // What one load worker produced for its chunk of a text file.
+        struct ParsedChunk {
+            const char* begin = nullptr;  // where the worker started
+            const char* next = nullptr;   // just past its last complete record
+            bool stopped = false;         // a malformed field ended the parse
+            std::vector<TextRecord> records;
+        };
 
-            Task task(desc, static_cast<Priority>(prioInt), due);
-            task.completed = static_cast<bool>(compInt);
-            tasks.push_back(task);
+        void parseChunk(ParsedChunk& chunk, const char* begin, const char* limit, const char* end) {
+            chunk.begin = begin;
+            chunk.next = begin;
+            chunk.records.clear();
+            chunk.stopped = !scanTextRecords(chunk.next, end, limit,
+                [&chunk](const TextRecord& record) { chunk.records.push_back(record); });
         }
-        file.close();
 
-        // Sync nextId if tasks loaded
-        int maxID = 0;
-        for (auto& task : tasks) {
-            if (task.id > maxID) maxID = task.id;
+        // Binary snapshot layout (native little-endian):
+        //   SnapshotHeader | SnapshotRecord[recordCount] | description blob
+        // Each record points at its description by offset/length into the blob.
+        // Version 2 added task IDs to the records and nextId to the header;
+        // version 1 files are still read and get fresh IDs.
+        const char snapshotMagic[4] = { 'T', 'D', 'L', 'B' };
+        const uint32_t snapshotVersion = 2;
+
+        struct SnapshotHeader {
+            char magic[4];
+            uint32_t version;
+            uint64_t recordCount;
+            uint64_t blobSize;
+            int64_t nextId;  // reserved (zero) in version 1
+        };
+
+        struct SnapshotRecordV1 {
+            int64_t dueDate;
+            uint64_t descOffset;
+            uint32_t descLength;
+            uint8_t priority;
+            uint8_t completed;
+            uint16_t reserved;
+        };
+
+        struct SnapshotRecord {
+            int64_t dueDate;
+            uint64_t descOffset;
+            uint32_t descLength;
+            int32_t id;
+            uint8_t priority;
+            uint8_t completed;
+            uint8_t reserved[6];
+        };
+
+        static_assert(sizeof(SnapshotHeader) == 32, "snapshot header must stay 32 bytes");
+        static_assert(sizeof(SnapshotRecordV1) == 24, "version 1 snapshot records are 24 bytes");
+        static_assert(sizeof(SnapshotRecord) == 32, "snapshot records must stay 32 bytes");
+
+        // Magic plus a plausible version word; the version bytes are
+        // control characters, so a text file can't match by accident.
+        bool looksLikeSnapshot(const char* pos, const char* end) {
+            if (static_cast<size_t>(end - pos) < sizeof(SnapshotHeader)) return false;
+            uint32_t version = 0;
+            memcpy(&version, pos + sizeof(snapshotMagic), sizeof(version));
+            return memcmp(pos, snapshotMagic, sizeof(snapshotMagic)) == 0
+                && version >= 1 && version <= snapshotVersion;
         }
-        nextId = maxID + 1;
-    }
 
-    void Task::saveTasksToFile(const std::string& filename) {
-        std::ofstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << "Error: Unable to open file for saving.\n";
-            return;
+        /*--------------------- write-ahead journal ---------------------*/
+
+        // Journal layout: an 8-byte header, then framed records
+        //   u32 payload length | u32 FNV-1a checksum | payload
+        // A torn or corrupt frame ends replay; everything before it is kept.
+        const char journalMagic[4] = { 'T', 'D', 'L', 'J' };
+        const uint32_t journalVersion = 1;
+        const size_t journalHeaderSize = 8;
+        const size_t journalFrameSize = 8;
+
+        enum JournalRecordType : uint8_t {
+            // Marks the state a snapshot was taken from: content fingerprint,
+            // nextId and (in journals from before snapshots stored IDs) the
+            // IDs of the live tasks in snapshot order.
+            JournalBase = 1,
+            JournalAdd = 2,
+            JournalUpdate = 3,
+            JournalDelete = 4
+        };
+
+        enum JournalUpdateField : uint8_t {
+            UpdateDescription = 1,
+            UpdatePriority = 2,
+            UpdateCompleted = 4,
+            UpdateDueDate = 8
+        };
+
+        template <typename T>
+        void putValue(std::string& out, T value) {
+            char bytes[sizeof(T)];
+            memcpy(bytes, &value, sizeof(T));
+            out.append(bytes, sizeof(T));
         }
-        for (auto& task : tasks) {
-            if (!validateTask(task.description, task.priority)) {
-                std::cerr << "Error: Invalid Task with ID " << task.id << " - not saved.\n";
-                continue;
+
+        template <typename T>
+        bool getValue(const char*& pos, const char* end, T& value) {
+            if (static_cast<size_t>(end - pos) < sizeof(T)) return false;
+            memcpy(&value, pos, sizeof(T));
+            pos += sizeof(T);
+            return true;
+        }
+
+        void putString(std::string& out, std::string_view str) {
+            putValue<uint32_t>(out, static_cast<uint32_t>(str.size()));
+            out += str;
+        }
+
+        bool getString(const char*& pos, const char* end, std::string_view& str) {
+            uint32_t length = 0;
+            if (!getValue(pos, end, length) || static_cast<size_t>(end - pos) < length) return false;
+            str = std::string_view(pos, length);
+            pos += length;
+            return true;
+        }
+
+        bool getString(const char*& pos, const char* end, std::string& str) {
+            std::string_view view;
+            if (!getString(pos, end, view)) return false;
+            str.assign(view.data(), view.size());
+            return true;
+        }
+
+        uint32_t checksum32(const char* data, size_t length) {
+            uint32_t hash = 2166136261u;
+            for (size_t i = 0; i < length; ++i) {
+                hash = (hash ^ static_cast<uint8_t>(data[i])) * 16777619u;
             }
-            // Format: description|priority completed dueDate
-            file << task.description << "|"
-                << task.priority << " "
-                << task.completed << " "
-                << task.dueDate << "\n";
+            return hash;
         }
-        file.close();
+
+        std::string frameRecord(const std::string& payload) {
+            std::string record;
+            record.reserve(journalFrameSize + payload.size());
+            putValue<uint32_t>(record, static_cast<uint32_t>(payload.size()));
+            putValue<uint32_t>(record, checksum32(payload.data(), payload.size()));
+            record += payload;
+            return record;
+        }
+
+        bool syncToDisk(FILE* file) {
+            if (fflush(file) != 0) return false;
+#ifdef _WIN32
+            return _commit(_fileno(file)) == 0;
+#else
+            return fsync(fileno(file)) == 0;
+#endif
+        }
+
+        bool syncPathToDisk(const std::string& path) {
+            FILE* file = fopen(path.c_str(), "ab");
+            if (!file) return false;
+            bool ok = syncToDisk(file);
+            fclose(file);
+            return ok;
+        }
+
     }
 
-    void Task::addTask(const std::string& desc, Priority prio, time_t due) {
-        if (validateTask(desc, prio)) {
-            tasks.push_back(Task(desc, prio, due));
+    struct TaskList::JournalState {
+        bool open = false;
+        bool replaying = false;
+        std::string snapshotFile;
+        std::string journalFile;
+        FileFormat format = FileFormat::Text;
+        JournalOptions options;
+        FILE* out = nullptr;
+        size_t bytes = 0;          // current journal length
+        size_t unsynced = 0;       // records appended since the last fsync
+        size_t compactAt = 0;      // journal length that triggers compaction
+
+        // Background compaction: `worker` writes the captured snapshot;
+        // once it lands, the journal is cut back to the Base record
+        // written at `baseOffset` when the snapshot was captured.
+        bool compacting = false;
+        size_t baseOffset = 0;
+        std::thread worker;
+        std::atomic<bool> workerDone{ false };
+        bool workerOk = false;
+
+        ~JournalState() {
+            if (worker.joinable()) worker.join();
+            if (out) fclose(out);
+        }
+    };
+
+    struct TaskList::AutosaveState {
+        std::string filename;
+        AutosaveOptions options;
+        std::thread worker;
+
+        // Guards the flags below. Lock order: the list's storeMutex first.
+        std::mutex mutex;
+        std::condition_variable wake;     // a change, a flush or stop
+        std::condition_variable written;  // the worker finished a write
+        bool pending = false;   // changes the worker has not captured yet
+        bool writing = false;   // a captured version is being written
+        bool flushing = false;  // someone waits; skip the delay
+        bool stopping = false;
+        size_t writes = 0;
+    };
+
+    namespace
+    {
+        std::string addRecord(int id, Priority prio, time_t due, std::string_view desc) {
+            std::string payload;
+            putValue<uint8_t>(payload, JournalAdd);
+            putValue<int32_t>(payload, id);
+            putValue<uint8_t>(payload, static_cast<uint8_t>(prio));
+            putValue<int64_t>(payload, static_cast<int64_t>(due));
+            putString(payload, desc);
+            return frameRecord(payload);
+        }
+
+        std::string updateRecord(int id,
+            const std::optional<std::string>& desc,
+            const std::optional<Priority>& prio,
+            const std::optional<bool>& comp,
+            const std::optional<time_t>& due)
+        {
+            std::string payload;
+            putValue<uint8_t>(payload, JournalUpdate);
+            putValue<int32_t>(payload, id);
+            uint8_t fields = (desc ? UpdateDescription : 0) | (prio ? UpdatePriority : 0)
+                | (comp ? UpdateCompleted : 0) | (due ? UpdateDueDate : 0);
+            putValue<uint8_t>(payload, fields);
+            if (desc) putString(payload, *desc);
+            if (prio) putValue<uint8_t>(payload, static_cast<uint8_t>(*prio));
+            if (comp) putValue<uint8_t>(payload, *comp ? 1 : 0);
+            if (due) putValue<int64_t>(payload, static_cast<int64_t>(*due));
+            return frameRecord(payload);
+        }
+
+        std::string deleteRecord(int id) {
+            std::string payload;
+            putValue<uint8_t>(payload, JournalDelete);
+            putValue<int32_t>(payload, id);
+            return frameRecord(payload);
         }
     }
 
-    void Task::deleteTask(int id) {
-        size_t oldSize = tasks.size();
-        tasks.erase(std::remove_if(tasks.begin(), tasks.end(),
-            [id](const Task& t) { return t.id == id; }),
-            tasks.end());
-        if (tasks.size() == oldSize) {
-            std::cerr << "Warning: No task found with ID " << id << ".\n";
+    FileFormat formatForFile(const std::string& filename) {
+        const std::string ext = ".bin";
+        if (filename.size() >= ext.size()
+            && filename.compare(filename.size() - ext.size(), ext.size(), ext) == 0) {
+            return FileFormat::Binary;
         }
+        return FileFormat::Text;
     }
 
-    void Task::updateTask(int id,
-        std::optional<std::string> desc,
-        std::optional<Priority> prio,
-        std::optional<bool> comp,
-        std::optional<time_t> due)
+    /*----------------------------- RADIX SORT ----------------------------*/
+
+    namespace
     {
-        for (auto& task : tasks) {
-            if (task.id == id) {
-                if (desc) {
-                    if (!validateTask(*desc, task.priority)) {
-                        std::cerr << "Update failed due to invalid description.\n";
-                        return;
-                    }
-                    task.description = *desc;
-                }
-                if (prio) {
-                    if (!validateTask(task.description, *prio)) {
-                        std::cerr << "Update failed due to invalid priority.\n";
-                        return;
-                    }
-                    task.priority = *prio;
+        // Maps an integer key to an unsigned one with the same order
+        // (signed keys get their sign bit flipped).
+        template <typename Key>
+        std::make_unsigned_t<Key> radixBits(Key key) {
+            using Bits = std::make_unsigned_t<Key>;
+            Bits bits = static_cast<Bits>(key);
+            if (std::is_signed<Key>::value) bits ^= static_cast<Bits>(Bits(1) << (sizeof(Key) * 8 - 1));
+            return bits;
+        }
+
+        // Stable ascending LSD radix sort of [first, last) by the integer
+        // keyOf(item), one byte per pass, with `scratch` (room for
+        // last - first items) as the second buffer. Descending views walk
+        // the result backwards, so there is no descending variant. Passes
+        // in which every key has the same byte are skipped, so a one-byte
+        // key (priority) is a single counting sort.
+        template <typename T, typename KeyOf>
+        void radixSort(T* first, T* last, T* scratch, KeyOf keyOf) {
+            using Bits = decltype(radixBits(keyOf(*first)));
+            constexpr size_t passes = sizeof(Bits);
+            size_t count = static_cast<size_t>(last - first);
+            if (count < 2) return;
+
+            // One read of the keys fills every pass's histogram.
+            std::vector<size_t> counts(passes * 256, 0);
+            for (T* item = first; item != last; ++item) {
+                Bits bits = radixBits(keyOf(*item));
+                for (size_t pass = 0; pass < passes; ++pass) {
+                    counts[pass * 256 + ((bits >> (pass * 8)) & 0xFF)]++;
                 }
-                if (comp) {
-                    task.completed = *comp;
+            }
+
+            T* from = first;
+            T* to = scratch;
+            for (size_t pass = 0; pass < passes; ++pass) {
+                size_t* buckets = &counts[pass * 256];
+                if (buckets[(radixBits(keyOf(*from)) >> (pass * 8)) & 0xFF] == count) continue;
+                size_t offset = 0;
+                for (size_t i = 0; i < 256; ++i) {
+                    size_t size = buckets[i];
+                    buckets[i] = offset;
+                    offset += size;
                 }
-                if (due) {
-                    task.dueDate = *due;
+                for (T* item = from; item != from + count; ++item) {
+                    to[buckets[(radixBits(keyOf(*item)) >> (pass * 8)) & 0xFF]++] = std::move(*item);
                 }
-                return;
+                std::swap(from, to);
+            }
+            if (from != first) {
+                std::move(from, from + count, first);
             }
         }
-        std::cerr << "Warning: No task found with ID " << id << ".\n";
+
+        // Puts (key, id) pairs in (key, id) order: by ID first unless they
+        // already are (the usual case, tasks being added in ID order), then
+        // stably by keyOf.
+        template <typename Key, typename KeyOf>
+        void radixSortKeyPairs(std::pair<Key, int>* first, std::pair<Key, int>* last,
+            std::pair<Key, int>* scratch, KeyOf keyOf) {
+            auto byId = [](const std::pair<Key, int>& a, const std::pair<Key, int>& b) {
+                return a.second < b.second;
+            };
+            if (!std::is_sorted(first, last, byId)) {
+                radixSort(first, last, scratch, [](const std::pair<Key, int>& entry) {
+                    return entry.second;
+                });
+            }
+            radixSort(first, last, scratch, keyOf);
+        }
     }
 
-    void Task::displayTasks() {
-        if (tasks.empty()) {
-            std::cout << "No tasks available.\n";
-            return;
+    /*---------------------------- WORKER POOL ----------------------------*/
+
+    namespace
+    {
+        // Threads shared by every parallel operation (text loads, sorts,
+        // filters). A job is a numbered set of tasks; idle workers and the
+        // calling thread take the next unclaimed number until none are left,
+        // so a slow chunk doesn't hold back the others.
+        class WorkerPool {
+        public:
+            static WorkerPool& shared() {
+                // The calling thread always takes part, hence one fewer.
+                static WorkerPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+                return pool;
+            }
+
+            explicit WorkerPool(unsigned workers) {
+                for (unsigned i = 0; i < workers; ++i) {
+                    threads.emplace_back([this] { workerLoop(); });
+                }
+            }
+            WorkerPool(const WorkerPool&) = delete;
+            WorkerPool& operator=(const WorkerPool&) = delete;
+
+            ~WorkerPool() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stopping = true;
+                }
+                wake.notify_all();
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+            }
+
+            // Threads a job can run on, the caller included.
+            unsigned threadCount() const { return static_cast<unsigned>(threads.size()) + 1; }
+
+            // Calls task(0) .. task(count - 1) and returns when all are done.
+            // One job runs at a time; a task must not start another.
+            void run(size_t count, const std::function<void(size_t)>& task) {
+                std::lock_guard<std::mutex> exclusive(jobMutex);
+                std::unique_lock<std::mutex> lock(mutex);
+                job = &task;
+                jobCount = count;
+                nextTask = 0;
+                finished = 0;
+                wake.notify_all();
+                runTasks(lock);
+                done.wait(lock, [this] { return finished == jobCount; });
+                job = nullptr;
+            }
+
+        private:
+            // Called with `mutex` held; tasks themselves run unlocked.
+            void runTasks(std::unique_lock<std::mutex>& lock) {
+                while (job && nextTask < jobCount) {
+                    size_t index = nextTask++;
+                    const auto& task = *job;
+                    lock.unlock();
+                    task(index);
+                    lock.lock();
+                    if (++finished == jobCount) done.notify_all();
+                }
+            }
+
+            void workerLoop() {
+                std::unique_lock<std::mutex> lock(mutex);
+                for (;;) {
+                    wake.wait(lock, [this] { return stopping || (job && nextTask < jobCount); });
+                    if (stopping) return;
+                    runTasks(lock);
+                }
+            }
+
+            std::vector<std::thread> threads;
+            std::mutex jobMutex;  // serializes run()
+            std::mutex mutex;     // guards everything below
+            std::condition_variable wake;
+            std::condition_variable done;
+            const std::function<void(size_t)>* job = nullptr;
+            size_t jobCount = 0;
+            size_t nextTask = 0;
+            size_t finished = 0;
+            bool stopping = false;
+        };
+
+        ParallelOptions parallelOptions;
+
+        // Threads to spend on an operation over `items` tasks: 1 below the
+        // threshold, otherwise the configured count (default: the pool's).
+        unsigned parallelThreads(size_t items) {
+            if (items < parallelOptions.minParallelTasks) return 1;
+            if (parallelOptions.threads != 0) return parallelOptions.threads;
+            return WorkerPool::shared().threadCount();
         }
 
-        std::cout << std::left << std::setw(5) << "ID"
-            << std::setw(25) << "Description"
-            << std::setw(10) << "Priority"
-            << std::setw(10) << "Status"
-            << std::setw(20) << "Due Date"
-            << std::endl;
+        // Calls task(0) .. task(count - 1): on the shared pool when `threads`
+        // is above 1, otherwise in order on this thread.
+        void parallelFor(unsigned threads, size_t count, const std::function<void(size_t)>& task) {
+            if (threads <= 1 || count <= 1) {
+                for (size_t i = 0; i < count; ++i) task(i);
+                return;
+            }
+            WorkerPool::shared().run(count, task);
+        }
 
-        for (auto& task : tasks) {
-            char buffer[20];
-            tm timeStruct{};
-            // localtime_s returns 0 on success (MSVC).
-            if (localtime_s(&timeStruct, &task.dueDate) == 0) {
-                strftime(buffer, sizeof(buffer), "%Y-%m-%d", &timeStruct);
+        // Sorts `pieces` slices of `items` concurrently with
+        // sortSlice(first, last, scratch), then merges them pairwise, each
+        // round's merges running concurrently as well. The result is the
+        // same as a serial sort's whenever no two items compare equal, which
+        // holds for the (key, id) pairs sorted here.
+        template <typename T, typename SliceSort>
+        void parallelSort(std::vector<T>& items, unsigned pieces, SliceSort&& sortSlice) {
+            std::vector<T> merged(items.size());
+            if (pieces <= 1 || items.size() < pieces) {
+                sortSlice(items.data(), items.data() + items.size(), merged.data());
+                return;
             }
-            else {
-                strcpy_s(buffer, "InvalidDate");
+            std::vector<size_t> bounds(pieces + 1);
+            for (size_t i = 0; i <= pieces; ++i) {
+                bounds[i] = items.size() * i / pieces;
             }
+            parallelFor(pieces, pieces, [&](size_t i) {
+                sortSlice(items.data() + bounds[i], items.data() + bounds[i + 1], merged.data() + bounds[i]);
+            });
 
-            std::cout << std::left << std::setw(5) << task.id
-                << std::setw(25) << task.description
-                << std::setw(10) << priorityToString(task.priority)
-                << std::setw(10) << (task.completed ? "Completed" : "Pending")
-                << std::setw(20) << buffer
-                << std::endl;
+            for (size_t width = 1; width < pieces; width *= 2) {
+                size_t merges = (pieces + 2 * width - 1) / (2 * width);
+                parallelFor(pieces, merges, [&](size_t m) {
+                    size_t first = m * 2 * width;
+                    size_t middle = std::min<size_t>(first + width, pieces);
+                    size_t last = std::min<size_t>(first + 2 * width, pieces);
+                    std::merge(items.begin() + bounds[first], items.begin() + bounds[middle],
+                        items.begin() + bounds[middle], items.begin() + bounds[last],
+                        merged.begin() + bounds[first]);
+                });
+                items.swap(merged);
+            }
         }
-    }
 
-    void Task::sortTasksByPriority(bool ascending) {
-        std::sort(tasks.begin(), tasks.end(),
-            [ascending](const Task& a, const Task& b) {
-                return ascending ? (a.priority < b.priority)
-                    : (a.priority > b.priority);
+        // Splits bitset words [0, words) into one range per thread and has
+        // each thread collect the matching slots of its range in its own
+        // list via scan(firstWord, lastWord, list). Read the lists in order
+        // for the slots in slot order.
+        template <typename Scan>
+        std::vector<std::vector<size_t>> collectSlots(size_t words, unsigned threads, Scan&& scan) {
+            std::vector<std::vector<size_t>> lists(threads);
+            parallelFor(threads, threads, [&](size_t i) {
+                scan(words * i / threads, words * (i + 1) / threads, lists[i]);
             });
+            return lists;
+        }
     }
 
-    void Task::sortTasksByDueDate(bool ascending) {
-        std::sort(tasks.begin(), tasks.end(),
-            [ascending](const Task& a, const Task& b) {
-                return ascending ? (a.dueDate < b.dueDate)
-                    : (a.dueDate > b.dueDate);
-            });
+    void setParallelOptions(ParallelOptions options) {
+        parallelOptions = options;
     }
 
-    void Task::filterTasksByStatus(bool completedStatus) {
-        bool foundAny = false;
-        std::cout << std::left << std::setw(5) << "ID"
-            << std::setw(25) << "Description"
-            << std::setw(10) << "Priority"
-            << std::setw(10) << "Status"
-            << std::setw(20) << "Due Date"
-            << std::endl;
-
-        for (auto& task : tasks) {
-            if (task.completed == completedStatus) {
-                foundAny = true;
-                char buffer[20];
-                tm timeStruct{};
-                if (localtime_s(&timeStruct, &task.dueDate) == 0) {
-                    strftime(buffer, sizeof(buffer), "%Y-%m-%d", &timeStruct);
-                }
-                else {
-                    strcpy_s(buffer, "InvalidDate");
-                }
+    /*------------------------ DESCRIPTION ARENA -------------------------*/
 
-                std::cout << std::left << std::setw(5) << task.id
-                    << std::setw(25) << task.description
-                    << std::setw(10) << priorityToString(task.priority)
-                    << std::setw(10) << (task.completed ? "Completed" : "Pending")
-                    << std::setw(20) << buffer
-                    << std::endl;
-            }
+    TaskList::StringArena::StringArena(const StringArena& other)
+        : blocks(other.blocks)
+    {}
+
+    // The copy shares the blocks (so views into them stay valid on both
+    // sides) but starts its own block and intern table for new strings.
+    TaskList::StringArena& TaskList::StringArena::operator=(const StringArena& other) {
+        if (this != &other) {
+            blocks = other.blocks;
+            blockUsed = 0;
+            blockSize = 0;
+            table.clear();
+            storedCount = 0;
+            storedBytes = 0;
         }
-        if (!foundAny) {
-            std::cout << "No tasks found with status: "
-                << (completedStatus ? "Completed" : "Pending") << std::endl;
+        return *this;
+    }
+
+    // The intern table is a direct-mapped cache of bounded size: a collision
+    // simply replaces the older entry. Repeated descriptions still end up
+    // stored once, while a list of distinct ones never pays for a table
+    // as large as itself.
+    std::string_view TaskList::StringArena::intern(std::string_view text) {
+        if (text.empty()) return {};
+        if (storedCount >= table.size() && table.size() < internTableSize) growTable();
+        uint32_t hash = static_cast<uint32_t>(std::hash<std::string_view>()(text));
+        InternEntry& entry = table[hash & (table.size() - 1)];
+        // The cached hash settles most mismatches without touching the text.
+        if (entry.data && entry.hash == hash && entry.length == text.size()
+            && memcmp(entry.data, text.data(), text.size()) == 0) {
+            return std::string_view(entry.data, entry.length);
         }
+        std::string_view stored = copyIn(text);
+        entry = { stored.data(), static_cast<uint32_t>(stored.size()), hash };
+        ++storedCount;
+        return stored;
     }
 
-    void Task::displayCompletionPercentage() {
-        if (tasks.empty()) {
-            std::cout << "No tasks. Completion percentage: 0%\n";
-            return;
+    // Quadruples the table, re-placing the cached entries by their hash.
+    void TaskList::StringArena::growTable() {
+        size_t size = table.empty() ? firstTableSize : std::min(table.size() * 4, internTableSize);
+        std::vector<InternEntry> grown(size, InternEntry{ nullptr, 0, 0 });
+        for (const InternEntry& entry : table) {
+            if (entry.data) grown[entry.hash & (size - 1)] = entry;
         }
-        int completedCount = 0;
-        for (auto& task : tasks) {
-            if (task.completed) {
-                completedCount++;
-            }
+        table.swap(grown);
+    }
+
+    std::string_view TaskList::StringArena::copyIn(std::string_view text) {
+        if (blockSize - blockUsed < text.size()) {
+            // Each block doubles the last, up to arenaBlockSize; oversized
+            // strings get a block of their own.
+            blockSize = std::max(std::min(arenaBlockSize, std::max(firstBlockSize, blockSize * 2)), text.size());
+            blocks.push_back(std::shared_ptr<char[]>(new char[blockSize]));
+            blockUsed = 0;
         }
-        double percentage = (static_cast<double>(completedCount) / tasks.size()) * 100.0;
-        std::cout << "Completion Percentage: "
-            << std::fixed << std::setprecision(2) << percentage << "%\n";
+        char* dest = blocks.back().get() + blockUsed;
+        memcpy(dest, text.data(), text.size());
+        blockUsed += text.size();
+        storedBytes += text.size();
+        return std::string_view(dest, text.size());
+    }
+
+    void TaskList::StringArena::clear() {
+        blocks.clear();
+        blockUsed = 0;
+        blockSize = 0;
+        table.clear();
+        storedCount = 0;
+        storedBytes = 0;
+    }
+
+    /*------------------------- COLUMNAR TASK STORE -----------------------*/
+
+    void TaskList::TaskStore::push(int id, std::string_view desc, Priority prio, bool comp, time_t due) {
+        pushShared(id, text.intern(desc), prio, comp, due);
+    }
+
+    void TaskList::TaskStore::pushShared(int id, std::string_view desc, Priority prio, bool comp, time_t due) {
+        size_t slot = ids.size();
+        if (slot % 64 == 0) {
+            completedBits.push_back(0);
+            liveBits.push_back(0);
+        }
+        ids.push_back(id);
+        priorities.push_back(static_cast<uint8_t>(prio));
+        dueDates.push_back(due);
+        descriptions.push_back(desc);
+        descriptionBytes += desc.size();
+        liveBits[slot / 64] |= uint64_t(1) << (slot % 64);
+        ++liveByPriority[priorityBucket(prio)];
+        setCompleted(slot, comp);
+    }
+
+    bool TaskList::TaskStore::isLive(size_t slot) const {
+        return (liveBits[slot / 64] >> (slot % 64)) & 1;
     }
 
+    bool TaskList::TaskStore::isCompleted(size_t slot) const {
+        return (completedBits[slot / 64] >> (slot % 64)) & 1;
+    }
+
+    void TaskList::TaskStore::setCompleted(size_t slot, bool value) {
+        if (isCompleted(slot) == value) return;
+        setCompletedBit(slot, value);
+        if (isLive(slot)) {
+            size_t& count = completedByPriority[priorityBucket(priorities[slot])];
+            count = value ? count + 1 : count - 1;
+        }
+    }
+
+    void TaskList::TaskStore::setCompletedBit(size_t slot, bool value) {
+        uint64_t mask = uint64_t(1) << (slot % 64);
+        if (value) {
+            completedBits[slot / 64] |= mask;
+        }
+        else {
+            completedBits[slot / 64] &= ~mask;
+        }
+    }
+
+    void TaskList::TaskStore::setPriority(size_t slot, Priority prio) {
+        if (isLive(slot)) {
+            size_t from = priorityBucket(priorities[slot]);
+            size_t to = priorityBucket(prio);
+            --liveByPriority[from];
+            ++liveByPriority[to];
+            if (isCompleted(slot)) {
+                --completedByPriority[from];
+                ++completedByPriority[to];
+            }
+        }
+        priorities[slot] = static_cast<uint8_t>(prio);
+    }
+
+    // Clearing the completion bit as well keeps completedBits a subset of
+    // liveBits, so counting completed tasks needs no masking.
+    void TaskList::TaskStore::markRemoved(size_t slot) {
+        if (!isLive(slot)) return;
+        setCompleted(slot, false);  // while still live, so the counts follow
+        --liveByPriority[priorityBucket(priorities[slot])];
+        liveBits[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+        descriptionBytes -= descriptions[slot].size();
+        descriptions[slot] = {};
+    }
+
+    size_t TaskList::TaskStore::countLive() const {
+        size_t count = 0;
+        for (size_t live : liveByPriority) count += live;
+        return count;
+    }
+
+    size_t TaskList::TaskStore::countCompleted() const {
+        size_t count = 0;
+        for (size_t completed : completedByPriority) count += completed;
+        return count;
+    }
+
+    void TaskList::TaskStore::reserve(size_t count) {
+        ids.reserve(count);
+        priorities.reserve(count);
+        dueDates.reserve(count);
+        descriptions.reserve(count);
+        completedBits.reserve((count + 63) / 64);
+        liveBits.reserve((count + 63) / 64);
+    }
+
+    void TaskList::TaskStore::clear() {
+        ids.clear();
+        priorities.clear();
+        dueDates.clear();
+        descriptions.clear();
+        completedBits.clear();
+        liveBits.clear();
+        text.clear();
+        std::fill(std::begin(liveByPriority), std::end(liveByPriority), 0);
+        std::fill(std::begin(completedByPriority), std::end(completedByPriority), 0);
+        descriptionBytes = 0;
+    }
+
+    // Slides the live slots down over the removed ones, column by column,
+    // then repacks the descriptions so deleted and overwritten text is freed.
+    void TaskList::TaskStore::compact() {
+        size_t out = 0;
+        for (size_t slot = 0; slot < size(); ++slot) {
+            if (!isLive(slot)) continue;
+            if (out != slot) {
+                ids[out] = ids[slot];
+                priorities[out] = priorities[slot];
+                dueDates[out] = dueDates[slot];
+                descriptions[out] = descriptions[slot];
+                setCompletedBit(out, isCompleted(slot));
+            }
+            ++out;
+        }
+        ids.resize(out);
+        priorities.resize(out);
+        dueDates.resize(out);
+        descriptions.resize(out);
+
+        size_t words = (out + 63) / 64;
+        completedBits.resize(words);
+        liveBits.assign(words, ~uint64_t(0));
+        if (out % 64 != 0) {
+            uint64_t tail = (uint64_t(1) << (out % 64)) - 1;
+            completedBits.back() &= tail;
+            liveBits.back() = tail;
+        }
+
+        StringArena repacked;
+        for (auto& desc : descriptions) {
+            desc = repacked.intern(desc);
+        }
+        text = std::move(repacked);
+    }
+
+    // Live slots only, with descriptions still pointing into (and keeping
+    // alive) this store's arena blocks: no text is copied.
+    TaskList::TaskStore TaskList::TaskStore::liveCopy() const {
+        TaskStore copy;
+        copy.text = text;
+        copy.reserve(size());
+        for (size_t slot = 0; slot < size(); ++slot) {
+            if (!isLive(slot)) continue;
+            copy.pushShared(ids[slot], descriptions[slot], static_cast<Priority>(priorities[slot]),
+                isCompleted(slot), dueDates[slot]);
+        }
+        return copy;
+    }
+
+    /*-------------------------- FULL-TEXT INDEX --------------------------*/
+
+    namespace
+    {
+        bool isWordByte(unsigned char c) {
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c >= 0x80;
+        }
+
+        // Splits `text` into words: runs of ASCII letters and digits or of
+        // non-ASCII bytes, so UTF-8 text splits on ASCII punctuation and
+        // spaces only. The text is lowercased into `lowered` and `words`
+        // gets views into it, in text order.
+        void splitWords(std::string_view text, std::string& lowered, std::vector<std::string_view>& words) {
+            lowered.resize(text.size());
+            for (size_t i = 0; i < text.size(); ++i) {
+                char c = text[i];
+                lowered[i] = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+            }
+            words.clear();
+            for (size_t i = 0; i < lowered.size();) {
+                if (!isWordByte(static_cast<unsigned char>(lowered[i]))) {
+                    ++i;
+                    continue;
+                }
+                size_t start = i;
+                while (i < lowered.size() && isWordByte(static_cast<unsigned char>(lowered[i]))) ++i;
+                words.emplace_back(lowered.data() + start, i - start);
+            }
+        }
+
+        // splitWords, keeping each word once.
+        void splitDistinctWords(std::string_view text, std::string& lowered, std::vector<std::string_view>& words) {
+            splitWords(text, lowered, words);
+            std::sort(words.begin(), words.end());
+            words.erase(std::unique(words.begin(), words.end()), words.end());
+        }
+
+        void putVarint(std::vector<uint8_t>& out, uint32_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        const uint8_t* getVarint(const uint8_t* pos, uint32_t& value) {
+            value = 0;
+            for (int shift = 0;; shift += 7) {
+                uint8_t byte = *pos++;
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return pos;
+            }
+        }
+
+        // Sorted union of sorted ID lists.
+        std::vector<int> unionOf(std::vector<std::vector<int>>& lists) {
+            if (lists.size() == 1) return std::move(lists[0]);
+            std::vector<int> result;
+            for (auto& list : lists) {
+                result.insert(result.end(), list.begin(), list.end());
+            }
+            std::sort(result.begin(), result.end());
+            result.erase(std::unique(result.begin(), result.end()), result.end());
+            return result;
+        }
+    }
+
+    void TaskList::TextIndex::decode(const Block& block, std::vector<int>& ids) {
+        ids.clear();
+        ids.push_back(block.firstId);
+        const uint8_t* pos = block.deltas.data();
+        int id = block.firstId;
+        for (uint32_t i = 1; i < block.count; ++i) {
+            uint32_t delta = 0;
+            pos = getVarint(pos, delta);
+            id += static_cast<int>(delta);
+            ids.push_back(id);
+        }
+    }
+
+    void TaskList::TextIndex::encode(Block& block, const int* first, const int* last) {
+        block.firstId = *first;
+        block.lastId = *(last - 1);
+        block.count = static_cast<uint32_t>(last - first);
+        block.deltas.clear();
+        for (const int* id = first + 1; id != last; ++id) {
+            putVarint(block.deltas, static_cast<uint32_t>(*id - *(id - 1)));
+        }
+    }
+
+    // The block that holds `id` if any list block does: the last one
+    // starting at or before it.
+    size_t TaskList::TextIndex::findBlock(const PostingList& list, int id) {
+        auto it = std::upper_bound(list.blocks.begin(), list.blocks.end(), id,
+            [](int value, const Block& block) { return value < block.firstId; });
+        return it == list.blocks.begin() ? 0 : static_cast<size_t>(it - list.blocks.begin()) - 1;
+    }
+
+    void TaskList::TextIndex::insertId(PostingList& list, int id) {
+        ++list.size;
+        // Tasks mostly arrive in ID order: append a delta, decode nothing.
+        if (!list.blocks.empty() && id > list.blocks.back().lastId
+            && list.blocks.back().count < maxBlockIds) {
+            Block& block = list.blocks.back();
+            putVarint(block.deltas, static_cast<uint32_t>(id - block.lastId));
+            block.lastId = id;
+            if (++block.count == maxBlockIds) block.deltas.shrink_to_fit();  // done growing
+            return;
+        }
+        if (list.blocks.empty() || id > list.blocks.back().lastId) {
+            list.blocks.emplace_back();
+            encode(list.blocks.back(), &id, &id + 1);
+            return;
+        }
+        size_t index = findBlock(list, id);
+        decode(list.blocks[index], ids);
+        auto it = std::lower_bound(ids.begin(), ids.end(), id);
+        if (it != ids.end() && *it == id) {
+            --list.size;
+            return;
+        }
+        ids.insert(it, id);
+        if (ids.size() <= maxBlockIds) {
+            encode(list.blocks[index], ids.data(), ids.data() + ids.size());
+            return;
+        }
+        size_t half = ids.size() / 2;
+        encode(list.blocks[index], ids.data(), ids.data() + half);
+        list.blocks.emplace(list.blocks.begin() + static_cast<std::ptrdiff_t>(index) + 1);
+        encode(list.blocks[index + 1], ids.data() + half, ids.data() + ids.size());
+    }
+
+    void TaskList::TextIndex::eraseId(PostingList& list, int id) {
+        if (list.blocks.empty()) return;
+        size_t index = findBlock(list, id);
+        Block& block = list.blocks[index];
+        if (id < block.firstId || id > block.lastId) return;
+        decode(block, ids);
+        auto it = std::lower_bound(ids.begin(), ids.end(), id);
+        if (it == ids.end() || *it != id) return;
+        ids.erase(it);
+        --list.size;
+        if (ids.empty()) {
+            list.blocks.erase(list.blocks.begin() + static_cast<std::ptrdiff_t>(index));
+        }
+        else {
+            encode(block, ids.data(), ids.data() + ids.size());
+        }
+    }
+
+    void TaskList::TextIndex::add(int id, std::string_view text) {
+        splitDistinctWords(text, lowered, words);
+        for (std::string_view word : words) {
+            auto it = terms.find(word);
+            if (it == terms.end()) {
+                std::string_view term = termText.intern(word);
+                it = terms.emplace(term, PostingList{}).first;
+                sortedTerms.insert(term);
+            }
+            insertId(it->second, id);
+        }
+    }
+
+    // A term whose list empties is dropped; its text stays in termText
+    // until clear().
+    void TaskList::TextIndex::remove(int id, std::string_view text) {
+        splitDistinctWords(text, lowered, words);
+        for (std::string_view word : words) {
+            auto it = terms.find(word);
+            if (it == terms.end()) continue;
+            eraseId(it->second, id);
+            if (it->second.size == 0) {
+                sortedTerms.erase(it->first);
+                terms.erase(it);
+            }
+        }
+    }
+
+    void TaskList::TextIndex::clear() {
+        terms.clear();
+        sortedTerms.clear();
+        termText.clear();
+    }
+
+    size_t TaskList::TextIndex::postingBytes() const {
+        size_t bytes = 0;
+        for (auto& term : terms) {
+            for (auto& block : term.second.blocks) {
+                bytes += sizeof(Block) + block.deltas.capacity();
+            }
+        }
+        return bytes;
+    }
+
+    std::vector<int> TaskList::TextIndex::idsOf(const PostingList& list) {
+        std::vector<int> ids;
+        ids.reserve(list.size);
+        std::vector<int> block;
+        for (auto& entry : list.blocks) {
+            decode(entry, block);
+            ids.insert(ids.end(), block.begin(), block.end());
+        }
+        return ids;
+    }
+
+    // Keeps the (ascending) IDs that are also in `list`. Both sides only
+    // move forward; the next block that can hold an ID is binary searched,
+    // and blocks no ID falls in are never decoded.
+    void TaskList::TextIndex::intersect(std::vector<int>& ids, const PostingList& list) {
+        if (list.blocks.empty()) {
+            ids.clear();
+            return;
+        }
+        size_t kept = 0;
+        std::vector<int> decoded;
+        size_t position = 0;
+        size_t block = 0;
+        size_t decodedBlock = list.blocks.size();
+        for (int id : ids) {
+            if (list.blocks[block].lastId < id) {
+                block = static_cast<size_t>(std::lower_bound(list.blocks.begin() + static_cast<std::ptrdiff_t>(block),
+                    list.blocks.end(), id,
+                    [](const Block& entry, int value) { return entry.lastId < value; }) - list.blocks.begin());
+                if (block == list.blocks.size()) break;
+            }
+            if (id < list.blocks[block].firstId) continue;
+            if (block != decodedBlock) {
+                decode(list.blocks[block], decoded);
+                decodedBlock = block;
+                position = 0;
+            }
+            while (decoded[position] < id) ++position;
+            if (decoded[position] == id) ids[kept++] = id;
+        }
+        ids.resize(kept);
+    }
+
+    // Words in a clause are ANDed, clauses ORed. Exact words are
+    // intersected smallest list first; a prefix word stands for the union
+    // of every term it starts.
+    std::vector<int> TaskList::TextIndex::search(std::string_view query) const {
+        struct Clause {
+            std::vector<std::string> exact;
+            std::vector<std::string> prefixes;
+        };
+        std::vector<Clause> clauses(1);
+        std::string tokenLowered;
+        std::vector<std::string_view> tokenWords;
+        size_t pos = 0;
+        while (pos < query.size()) {
+            size_t start = query.find_first_not_of(" \t", pos);
+            if (start == std::string_view::npos) break;
+            size_t stop = std::min(query.find_first_of(" \t", start), query.size());
+            std::string_view token = query.substr(start, stop - start);
+            pos = stop;
+            if (token == "OR" || token == "|") {
+                clauses.emplace_back();
+                continue;
+            }
+            bool prefix = token.back() == '*';
+            splitWords(token, tokenLowered, tokenWords);
+            for (size_t i = 0; i < tokenWords.size(); ++i) {
+                auto& target = prefix && i + 1 == tokenWords.size() ? clauses.back().prefixes : clauses.back().exact;
+                target.emplace_back(tokenWords[i]);
+            }
+        }
+
+        std::vector<std::vector<int>> matches;
+        for (auto& clause : clauses) {
+            if (clause.exact.empty() && clause.prefixes.empty()) continue;
+            std::vector<const PostingList*> lists;
+            bool missing = false;
+            for (auto& word : clause.exact) {
+                auto it = terms.find(word);
+                if (it == terms.end()) {
+                    missing = true;
+                    break;
+                }
+                lists.push_back(&it->second);
+            }
+            if (missing) continue;
+            std::sort(lists.begin(), lists.end(),
+                [](const PostingList* a, const PostingList* b) { return a->size < b->size; });
+
+            std::vector<std::vector<int>> prefixIds;
+            for (auto& prefix : clause.prefixes) {
+                std::vector<std::vector<int>> termIds;
+                for (auto it = sortedTerms.lower_bound(prefix);
+                    it != sortedTerms.end() && it->compare(0, prefix.size(), prefix) == 0; ++it) {
+                    termIds.push_back(idsOf(terms.find(*it)->second));
+                }
+                prefixIds.push_back(unionOf(termIds));
+            }
+
+            std::vector<int> clauseIds;
+            size_t nextList = 0;
+            if (!lists.empty()) {
+                clauseIds = idsOf(*lists[nextList++]);
+            }
+            else {
+                auto smallest = std::min_element(prefixIds.begin(), prefixIds.end(),
+                    [](const std::vector<int>& a, const std::vector<int>& b) { return a.size() < b.size(); });
+                clauseIds.swap(*smallest);
+                prefixIds.erase(smallest);
+            }
+            for (; nextList < lists.size() && !clauseIds.empty(); ++nextList) {
+                intersect(clauseIds, *lists[nextList]);
+            }
+            for (auto& other : prefixIds) {
+                std::vector<int> kept;
+                std::set_intersection(clauseIds.begin(), clauseIds.end(), other.begin(), other.end(),
+                    std::back_inserter(kept));
+                clauseIds.swap(kept);
+            }
+            matches.push_back(std::move(clauseIds));
+        }
+        return unionOf(matches);
+    }
+
+    /*----------------------------- TIMER WHEEL ---------------------------*/
+
+    namespace
+    {
+        // Hierarchical timing wheel over whole seconds. Level l has 64 slots
+        // of 64^l seconds; a timer sits on the level of the highest 6-bit
+        // digit in which its time differs from the wheel's current time, in
+        // the slot of its own digit there. Schedule and cancel are O(1);
+        // advancing jumps straight to the next occupied slot (found from a
+        // bitmap per level) and moves its timers down a level, so each
+        // timer is touched at most once per level however far time moves.
+        class TimerWheel {
+        public:
+            explicit TimerWheel(time_t now) : current(wheelKey(now)) {}
+
+            // Replaces any timer already set for `id`.
+            void schedule(int id, time_t when) {
+                cancel(id);
+                uint32_t node;
+                if (freeNodes.empty()) {
+                    node = static_cast<uint32_t>(nodes.size());
+                    nodes.emplace_back();
+                }
+                else {
+                    node = freeNodes.back();
+                    freeNodes.pop_back();
+                }
+                nodes[node].when = wheelKey(when);
+                nodes[node].id = id;
+                nodeOfId[id] = node;
+                place(node);
+            }
+
+            void cancel(int id) {
+                auto it = nodeOfId.find(id);
+                if (it == nodeOfId.end()) return;
+                unlink(it->second);
+                freeNodes.push_back(it->second);
+                nodeOfId.erase(it);
+            }
+
+            // Moves the wheel to `now` and appends the IDs whose time has come,
+            // earliest first (timers set in the past first of all). Time never
+            // moves backwards.
+            void advance(time_t now, std::vector<int>& due) {
+                uint64_t target = wheelKey(now);
+                takeExpired(due);
+                for (;;) {
+                    // The lowest level with an occupied slot after the current
+                    // digit holds the earliest timers: higher levels only hold
+                    // times past the end of that level's current block.
+                    size_t level = 0;
+                    uint64_t candidates = 0;
+                    for (; level < levels; ++level) {
+                        unsigned digit = static_cast<unsigned>((current >> (slotBits * level)) & (slots - 1));
+                        candidates = digit == slots - 1 ? 0 : occupied[level] & (~uint64_t(0) << (digit + 1));
+                        if (candidates != 0) break;
+                    }
+                    if (candidates == 0) break;
+                    size_t slot = std::bitset<64>((candidates & (~candidates + 1)) - 1).count();
+                    unsigned shift = static_cast<unsigned>(slotBits * level);
+                    uint64_t blockStart = shift + slotBits >= 64 ? 0 : current >> (shift + slotBits) << (shift + slotBits);
+                    uint64_t at = blockStart | (static_cast<uint64_t>(slot) << shift);
+                    if (at > target) break;
+
+                    current = at;
+                    List& list = lists[level * slots + slot];
+                    uint32_t node = list.head;
+                    list = List{};
+                    occupied[level] &= ~(uint64_t(1) << slot);
+                    while (node != none) {
+                        uint32_t next = nodes[node].next;
+                        place(node);
+                        node = next;
+                    }
+                    takeExpired(due);
+                }
+                current = std::max(current, target);
+            }
+
+            size_t size() const { return nodeOfId.size(); }
+
+        private:
+            static constexpr size_t slotBits = 6;
+            static constexpr size_t slots = size_t(1) << slotBits;
+            static constexpr size_t levels = (64 + slotBits - 1) / slotBits;
+            static constexpr size_t expiredList = levels * slots;
+            static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+            struct Node {
+                uint64_t when = 0;
+                int id = 0;
+                uint32_t prev = none;
+                uint32_t next = none;
+                uint32_t list = 0;
+            };
+            struct List {
+                uint32_t head = none;
+                uint32_t tail = none;
+            };
+
+            // Order-preserving map of time_t onto unsigned keys.
+            static uint64_t wheelKey(time_t when) {
+                return static_cast<uint64_t>(static_cast<int64_t>(when)) ^ (uint64_t(1) << 63);
+            }
+
+            void place(uint32_t node) {
+                uint64_t when = nodes[node].when;
+                if (when <= current) {
+                    link(expiredList, node);
+                    return;
+                }
+                uint64_t differing = when ^ current;
+                size_t level = 0;
+                while (level + 1 < levels && (differing >> (slotBits * (level + 1))) != 0) ++level;
+                size_t slot = static_cast<size_t>((when >> (slotBits * level)) & (slots - 1));
+                link(level * slots + slot, node);
+                occupied[level] |= uint64_t(1) << slot;
+            }
+
+            void link(size_t list, uint32_t node) {
+                Node& entry = nodes[node];
+                entry.list = static_cast<uint32_t>(list);
+                entry.prev = lists[list].tail;
+                entry.next = none;
+                if (entry.prev == none) lists[list].head = node;
+                else nodes[entry.prev].next = node;
+                lists[list].tail = node;
+            }
+
+            void unlink(uint32_t node) {
+                Node& entry = nodes[node];
+                List& list = lists[entry.list];
+                if (entry.prev == none) list.head = entry.next;
+                else nodes[entry.prev].next = entry.next;
+                if (entry.next == none) list.tail = entry.prev;
+                else nodes[entry.next].prev = entry.prev;
+                if (list.head == none && entry.list != expiredList) {
+                    occupied[entry.list / slots] &= ~(uint64_t(1) << (entry.list % slots));
+                }
+            }
+
+            // Timers set in the past arrive in any order, so the list is
+            // sorted on the way out.
+            void takeExpired(std::vector<int>& due) {
+                size_t first = freeNodes.size();
+                for (uint32_t node = lists[expiredList].head; node != none; node = nodes[node].next) {
+                    nodeOfId.erase(nodes[node].id);
+                    freeNodes.push_back(node);
+                }
+                lists[expiredList] = List{};
+                std::stable_sort(freeNodes.begin() + static_cast<std::ptrdiff_t>(first), freeNodes.end(),
+                    [this](uint32_t a, uint32_t b) { return nodes[a].when < nodes[b].when; });
+                for (size_t i = first; i < freeNodes.size(); ++i) {
+                    due.push_back(nodes[freeNodes[i]].id);
+                }
+            }
+
+            List lists[levels * slots + 1];
+            uint64_t occupied[levels] = {};
+            std::vector<Node> nodes;
+            std::vector<uint32_t> freeNodes;
+            std::unordered_map<int, uint32_t> nodeOfId;
+            uint64_t current;
+        };
+    }
+
+    struct TaskList::ReminderState {
+        ReminderState(std::function<void(const TaskRow&)> callback, ReminderOptions reminderOptions, time_t now)
+            : onDue(std::move(callback)), options(std::move(reminderOptions)), wheel(now) {}
+
+        std::function<void(const TaskRow&)> onDue;
+        ReminderOptions options;
+        TimerWheel wheel;
+        bool stale = false;  // tasks were replaced wholesale; reschedule on the next poll
+    };
+
+    /*-------------------- TASK CLASS IMPLEMENTATIONS ---------------------*/
+
+    TaskList::TaskList()
+        : journal(std::make_unique<JournalState>())
+    {}
+
+    TaskList::~TaskList() {
+        stopReminders();
+        stopAutosave();
+        closeJournal();
+    }
+
+    // Files from before descriptions were kept to one line may hold
+    // multi-line ones; those still load and save, they just can't be new.
+    bool TaskList::validateTask(std::string_view desc, Priority prio, bool newText) {
+        if (desc.empty()) {
+            std::cerr << "Error: Description cannot be empty.\n";
+            return false;
+        }
+        if (!fitsTextRecord(desc) || (newText && desc.find('\n') != std::string_view::npos)) {
+            std::cerr << "Error: Description cannot contain '|' or line breaks.\n";
+            return false;
+        }
+        if (prio < HIGHEST || prio > LOWEST) {
+            std::cerr << "Error: Priority must be between 1 and 5.\n";
+            return false;
+        }
+        return true;
+    }
+
+    // Adds a task read from a file or the journal. Records without an ID
+    // (id <= 0, i.e. older files) and duplicate IDs take the next free ID;
+    // either way nextId stays past every ID seen, in the same pass.
+    void TaskList::insertLoadedTask(int id, std::string_view desc, Priority prio, bool comp, time_t due) {
+        if (id > 0 && idIndex.count(id)) {
+            std::cerr << "Warning: Duplicate task ID " << id << " in file; assigning a new ID.\n";
+            id = 0;
+        }
+        if (id <= 0) {
+            id = nextId++;
+        }
+        else if (id >= nextId) {
+            nextId = id + 1;
+        }
+        idIndex[id] = store.size();
+        store.push(id, desc, prio, comp, due);
+    }
+
+    void TaskList::rebuildIndex() {
+        idIndex.clear();
+        idIndex.reserve(store.size());
+        for (size_t slot = 0; slot < store.size(); ++slot) {
+            if (store.isLive(slot)) idIndex[store.ids[slot]] = slot;
+        }
+    }
+
+    void TaskList::indexTask(size_t slot) {
+        scheduleReminder(slot);
+        if (textIndexBuilt) textIndex.add(store.ids[slot], store.descriptions[slot]);
+        if (dueBucketsBuilt) countInDueBucket(store.dueDates[slot], store.isCompleted(slot), true);
+        if (!sortedIndexesBuilt) return;
+        priorityIndex.insert({ store.priorities[slot], store.ids[slot] });
+        dueDateIndex.insert({ store.dueDates[slot], store.ids[slot] });
+    }
+
+    void TaskList::unindexTask(size_t slot) {
+        cancelReminder(store.ids[slot]);
+        if (textIndexBuilt) textIndex.remove(store.ids[slot], store.descriptions[slot]);
+        if (dueBucketsBuilt) countInDueBucket(store.dueDates[slot], store.isCompleted(slot), false);
+        if (!sortedIndexesBuilt) return;
+        priorityIndex.erase({ store.priorities[slot], store.ids[slot] });
+        dueDateIndex.erase({ store.dueDates[slot], store.ids[slot] });
+    }
+
+    // Bulk build on the first sort after a load: radix sort the keys once
+    // and hand the sets pre-sorted ranges, which they take in linear time.
+    // Large lists gather, sort and build on the worker pool.
+    void TaskList::rebuildSortedIndexes() {
+        size_t live = store.size() - removedCount;
+        unsigned threads = parallelThreads(live);
+        size_t words = store.liveBits.size();
+
+        // Each thread takes a range of whole bitset words; a popcount pass
+        // tells it where its live tasks go in the key arrays.
+        std::vector<size_t> offsets(threads + 1, 0);
+        parallelFor(threads, threads, [&](size_t i) {
+            for (size_t word = words * i / threads; word < words * (i + 1) / threads; ++word) {
+                offsets[i + 1] += std::bitset<64>(store.liveBits[word]).count();
+            }
+        });
+        for (size_t i = 0; i < threads; ++i) {
+            offsets[i + 1] += offsets[i];
+        }
+
+        std::vector<std::pair<int, int>> byPriority(live);
+        std::vector<std::pair<time_t, int>> byDueDate(live);
+        parallelFor(threads, threads, [&](size_t i) {
+            size_t out = offsets[i];
+            forEachSetBit(words * i / threads, words * (i + 1) / threads,
+                [this](size_t word) { return store.liveBits[word]; },
+                [&](size_t slot) {
+                    byPriority[out] = { store.priorities[slot], store.ids[slot] };
+                    byDueDate[out] = { store.dueDates[slot], store.ids[slot] };
+                    ++out;
+                });
+        });
+        parallelSort(byPriority, threads, [](auto* first, auto* last, auto* scratch) {
+            radixSortKeyPairs(first, last, scratch, [](const std::pair<int, int>& entry) {
+                return static_cast<uint8_t>(entry.first);  // 1..5: one counting pass
+            });
+        });
+        parallelSort(byDueDate, threads, [](auto* first, auto* last, auto* scratch) {
+            radixSortKeyPairs(first, last, scratch, [](const std::pair<time_t, int>& entry) {
+                return entry.first;
+            });
+        });
+
+        // Node allocation dominates now; the two sets build side by side.
+        parallelFor(threads, 2, [&](size_t which) {
+            if (which == 0) {
+                priorityIndex = std::set<std::pair<int, int>>(byPriority.begin(), byPriority.end());
+            }
+            else {
+                dueDateIndex = std::set<std::pair<time_t, int>>(byDueDate.begin(), byDueDate.end());
+            }
+        });
+        sortedIndexesBuilt = true;
+    }
+
+    void TaskList::dropSortedIndexes() {
+        priorityIndex.clear();
+        dueDateIndex.clear();
+        sortedIndexesBuilt = false;
+        sortOrder = SortOrder::Insertion;
+    }
+
+    // Visits the slots of live tasks in the order picked by the last sort call.
+    template <typename Visitor>
+    void TaskList::forEachInOrder(Visitor&& visit) {
+        auto visitId = [&visit, this](int id) { visit(idIndex.find(id)->second); };
+        switch (sortOrder) {
+        case SortOrder::Priority:
+            walkIndex(priorityIndex, sortAscending, visitId);
+            break;
+        case SortOrder::DueDate:
+            walkIndex(dueDateIndex, sortAscending, visitId);
+            break;
+        default:
+            forEachSetBit(0, store.liveBits.size(),
+                [this](size_t word) { return store.liveBits[word]; }, visit);
+            break;
+        }
+    }
+
+    // Drop tombstoned slots (keeping the order of the live ones) and
+    // re-point the index at the new slots. With no tombstones this still
+    // repacks the arena, dropping replaced descriptions.
+    void TaskList::compactTasks() {
+        std::vector<uint64_t> liveBefore = store.liveBits;
+        store.compact();
+        removedCount = 0;
+        rebuildIndex();
+        touchAllSlots();
+        compactedLiveBits = std::move(liveBefore);
+    }
+
+    void TaskList::loadTasksFromFile(const std::string& filename, FileFormat format, LoadOptions options) {
+        MYLIBRARY_TIME_OPERATION(Operation::Load);
+        StoreLock lock(*this);
+        MappedFile file;
+        if (!file.open(filename)) {
+            // If file not found, not necessarily an error; do nothing
+            return;
+        }
+
+        if (format == FileFormat::Auto) {
+            format = looksLikeSnapshot(file.begin(), file.end()) ? FileFormat::Binary
+                : formatForFile(filename);
+        }
+
+        store.clear();
+        idIndex.clear();
+        removedCount = 0;
+        nextId = 1;
+        dropSortedIndexes();
+        dropTextIndex();
+        dropDueBuckets();
+        if (reminders) reminders->stale = true;
+        touchAllSlots();
+
+        if (format == FileFormat::Binary) {
+            parseBinarySnapshot(file.begin(), file.end());
+        }
+        else {
+            int64_t savedNextId = 0;
+            const char* recordsEnd = findNextIdTrailer(file.begin(), file.end(), savedNextId);
+            parseTextRecords(file.begin(), recordsEnd, options);
+            // IDs of tasks deleted before the save stay retired.
+            if (savedNextId > nextId && savedNextId <= std::numeric_limits<int>::max()) {
+                nextId = static_cast<int>(savedNextId);
+            }
+        }
+        file.close();
+    }
+
+    void TaskList::parseTextRecords(const char* pos, const char* end, const LoadOptions& options) {
+        size_t bytes = static_cast<size_t>(end - pos);
+        unsigned workers = options.workers != 0 ? options.workers
+            : WorkerPool::shared().threadCount();
+        workers = static_cast<unsigned>(std::min<size_t>(workers,
+            bytes / std::max<size_t>(1, options.minBytesPerWorker)));
+
+        auto insertRecord = [this](const TextRecord& record) {
+            if (!record.valid) {
+                std::cerr << "Skipping invalid task from file.\n";
+                return;
+            }
+            insertLoadedTask(record.id, record.desc, static_cast<Priority>(record.prio),
+                static_cast<bool>(record.completed), record.due);
+        };
+
+        if (workers <= 1) {
+            // Pre-pass: one record per line, so the line count bounds the vector.
+            size_t lines = static_cast<size_t>(std::count(pos, end, '\n')) + 1;
+            store.reserve(lines);
+            idIndex.reserve(lines);
+            // Any malformed field stops the load, as the stream reader did.
+            scanTextRecords(pos, end, end, insertRecord);
+            return;
+        }
+
+        // Split at newlines and parse the chunks on the worker pool, each
+        // assuming a record starts right at its first byte.
+        std::vector<const char*> bounds{ pos };
+        for (unsigned i = 1; i < workers; ++i) {
+            const char* split = std::max(bounds.back(), pos + bytes * i / workers);
+            const char* newline = static_cast<const char*>(memchr(split, '\n', end - split));
+            bounds.push_back(newline ? newline + 1 : end);
+        }
+        bounds.push_back(end);
+
+        std::vector<ParsedChunk> chunks(workers);
+        parallelFor(workers, workers, [&](size_t i) {
+            parseChunk(chunks[i], bounds[i], bounds[i + 1], end);
+        });
+
+        size_t total = 0;
+        for (auto& chunk : chunks) {
+            total += chunk.records.size();
+        }
+        store.reserve(total);
+        idIndex.reserve(total);
+
+        // Merge in file order, so warnings and assigned IDs come out exactly
+        // as in a serial load. The assumption above only fails when a record
+        // spans a chunk boundary (a line without '|', fields split across
+        // lines); such a chunk is re-parsed from where the previous one
+        // really ended.
+        const char* expected = pos;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            ParsedChunk& chunk = chunks[i];
+            if (chunk.begin != expected) {
+                parseChunk(chunk, expected, std::max(expected, bounds[i + 1]), end);
+            }
+            for (auto& record : chunk.records) {
+                insertRecord(record);
+            }
+            if (chunk.stopped) break;
+            expected = chunk.next;
+            chunk.records = std::vector<TextRecord>();
+        }
+    }
+
+    // Records are copied straight out of the mapping; nothing is parsed.
+    void TaskList::parseBinarySnapshot(const char* pos, const char* end) {
+        SnapshotHeader header{};
+        size_t available = static_cast<size_t>(end - pos);
+        if (available < sizeof(header)) {
+            std::cerr << "Error: Binary task file is truncated.\n";
+            return;
+        }
+        memcpy(&header, pos, sizeof(header));
+        if (memcmp(header.magic, snapshotMagic, sizeof(snapshotMagic)) != 0) {
+            std::cerr << "Error: Not a binary task file.\n";
+            return;
+        }
+        if (header.version < 1 || header.version > snapshotVersion) {
+            std::cerr << "Error: Unsupported binary task file version " << header.version << ".\n";
+            return;
+        }
+        size_t recordSize = header.version == 1 ? sizeof(SnapshotRecordV1) : sizeof(SnapshotRecord);
+        size_t payload = available - sizeof(header);
+        if (header.recordCount > payload / recordSize
+            || header.blobSize != payload - header.recordCount * recordSize) {
+            std::cerr << "Error: Binary task file is truncated.\n";
+            return;
+        }
+
+        const char* records = pos + sizeof(header);
+        const char* blob = records + header.recordCount * recordSize;
+        store.reserve(static_cast<size_t>(header.recordCount));
+        idIndex.reserve(static_cast<size_t>(header.recordCount));
+        for (uint64_t i = 0; i < header.recordCount; ++i) {
+            SnapshotRecord record{};
+            if (header.version == 1) {
+                SnapshotRecordV1 old;
+                memcpy(&old, records + i * recordSize, sizeof(old));
+                record.dueDate = old.dueDate;
+                record.descOffset = old.descOffset;
+                record.descLength = old.descLength;
+                record.priority = old.priority;
+                record.completed = old.completed;
+            }
+            else {
+                memcpy(&record, records + i * recordSize, sizeof(record));
+            }
+            if (record.descOffset > header.blobSize
+                || record.descLength > header.blobSize - record.descOffset) {
+                std::cerr << "Error: Corrupt description reference in binary task file.\n";
+                break;
+            }
+            if (record.descLength == 0 || record.priority < HIGHEST || record.priority > LOWEST) {
+                std::cerr << "Skipping invalid task from file.\n";
+                continue;
+            }
+            insertLoadedTask(record.id, std::string_view(blob + record.descOffset, record.descLength),
+                static_cast<Priority>(record.priority), record.completed != 0,
+                static_cast<time_t>(record.dueDate));
+        }
+        // IDs of tasks deleted before the save stay retired.
+        if (header.nextId > nextId && header.nextId <= std::numeric_limits<int>::max()) {
+            nextId = static_cast<int>(header.nextId);
+        }
+    }
+
+    void TaskList::saveTasksToFile(const std::string& filename, FileFormat format) {
+        MYLIBRARY_TIME_OPERATION(Operation::Save);
+        StoreLock lock(*this);
+        if (journalCoversSnapshot(filename)) {
+            // Rewriting the journaled snapshot behind the journal's back would
+            // orphan it, so fold the journal into a new snapshot instead.
+            compactJournal();
+            return;
+        }
+        writeTasksFile(filename, format, store, nextId);
+    }
+
+    // Writes a temp file next to `filename`, syncs it and renames it over
+    // `filename`, so a crash leaves either the old file or the new one.
+    bool TaskList::replaceTasksFile(const std::string& filename, FileFormat format,
+        const TaskStore& list, int listNextId)
+    {
+        std::string tempFile = filename + ".tmp";
+        std::error_code ec;
+        bool ok = writeTasksFile(tempFile, format, list, listNextId) && syncPathToDisk(tempFile);
+        if (ok) std::filesystem::rename(tempFile, filename, ec);
+        if (!ok || ec) std::filesystem::remove(tempFile, ec);
+        return ok && !ec;
+    }
+
+    bool TaskList::writeTasksFile(const std::string& filename, FileFormat format,
+        const TaskStore& list, int listNextId)
+    {
+        if (format == FileFormat::Auto) {
+            format = formatForFile(filename);
+        }
+        std::ofstream file;
+        if (format == FileFormat::Binary) {
+            file.open(filename, std::ios::binary);
+        }
+        else {
+            file.open(filename);
+        }
+        if (!file.is_open()) {
+            std::cerr << "Error: Unable to open file for saving.\n";
+            return false;
+        }
+        if (format == FileFormat::Binary) {
+            writeBinarySnapshot(file, list, listNextId);
+        }
+        else {
+            writeTextRecords(file, list, listNextId);
+        }
+        std::streamoff written = file.tellp();
+        file.close();
+        if (file.fail()) return false;
+        countBytesWritten(static_cast<uint64_t>(written));
+        return true;
+    }
+
+    void TaskList::writeTextRecords(std::ostream& file, const TaskStore& list, int listNextId) {
+        for (size_t slot = 0; slot < list.size(); ++slot) {
+            if (!list.isLive(slot)) continue;
+            Priority prio = static_cast<Priority>(list.priorities[slot]);
+            if (!validateTask(list.descriptions[slot], prio, false)) {
+                std::cerr << "Error: Invalid Task with ID " << list.ids[slot] << " - not saved.\n";
+                continue;
+            }
+            // Format: description|priority completed dueDate id
+            // (the trailing ID is ignored by readers that predate it)
+            file << list.descriptions[slot] << "|"
+                << prio << " "
+                << list.isCompleted(slot) << " "
+                << list.dueDates[slot] << " "
+                << list.ids[slot] << "\n";
+        }
+        file << "#nextId " << listNextId << "\n";  // see findNextIdTrailer
+    }
+
+    void TaskList::writeBinarySnapshot(std::ostream& file, const TaskStore& list, int listNextId) {
+        std::vector<SnapshotRecord> records;
+        records.reserve(list.size());
+        std::string blob;
+        for (size_t slot = 0; slot < list.size(); ++slot) {
+            if (!list.isLive(slot)) continue;
+            // Descriptions are length-prefixed here, so unlike in text
+            // files every one of them can be stored.
+            std::string_view desc = list.descriptions[slot];
+            SnapshotRecord record{};
+            record.dueDate = static_cast<int64_t>(list.dueDates[slot]);
+            record.descOffset = blob.size();
+            record.descLength = static_cast<uint32_t>(desc.size());
+            record.id = list.ids[slot];
+            record.priority = list.priorities[slot];
+            record.completed = list.isCompleted(slot) ? 1 : 0;
+            records.push_back(record);
+            blob += desc;
+        }
+
+        SnapshotHeader header{};
+        memcpy(header.magic, snapshotMagic, sizeof(snapshotMagic));
+        header.version = snapshotVersion;
+        header.recordCount = records.size();
+        header.blobSize = blob.size();
+        header.nextId = listNextId;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(records.data()),
+            static_cast<std::streamsize>(records.size() * sizeof(SnapshotRecord)));
+        file.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+    }
+
+    int TaskList::addTask(const std::string& desc, Priority prio, time_t due) {
+        MYLIBRARY_TIME_OPERATION(Operation::Add);
+        StoreLock lock(*this);
+        if (!validateTask(desc, prio)) {
+            return 0;
+        }
+        int id = nextId++;
+        size_t slot = store.size();
+        store.push(id, desc, prio, false, due);
+        idIndex[id] = slot;
+        indexTask(slot);
+        if (journalActive()) {
+            appendJournalRecord(addRecord(id, prio, due, desc));
+        }
+        return id;
+    }
+
+    void TaskList::deleteTask(int id) {
+        MYLIBRARY_TIME_OPERATION(Operation::Delete);
+        StoreLock lock(*this);
+        auto it = idIndex.find(id);
+        if (it == idIndex.end()) {
+            std::cerr << "Warning: No task found with ID " << id << ".\n";
+            return;
+        }
+        // Tombstone the slot instead of shifting the tail; compact once
+        // half the store is dead so the cost stays amortized O(1).
+        unindexTask(it->second);
+        store.markRemoved(it->second);
+        touchSlot(it->second);
+        idIndex.erase(it);
+        ++removedCount;
+        if (removedCount > store.size() / 2) {
+            compactTasks();
+        }
+        if (journalActive()) {
+            appendJournalRecord(deleteRecord(id));
+        }
+    }
+
+    void TaskList::updateTask(int id,
+        std::optional<std::string> desc,
+        std::optional<Priority> prio,
+        std::optional<bool> comp,
+        std::optional<time_t> due)
+    {
+        MYLIBRARY_TIME_OPERATION(Operation::Update);
+        StoreLock lock(*this);
+        auto it = idIndex.find(id);
+        if (it == idIndex.end()) {
+            std::cerr << "Warning: No task found with ID " << id << ".\n";
+            return;
+        }
+        size_t slot = it->second;
+        // All or nothing, and checked before the slot is touched: a dirty
+        // slot means a snapshot to publish and a file for autosave to write.
+        if (desc && !validateTask(*desc, static_cast<Priority>(store.priorities[slot]))) {
+            std::cerr << "Update failed due to invalid description.\n";
+            return;
+        }
+        if (prio && !validateTask(store.descriptions[slot], *prio, false)) {
+            std::cerr << "Update failed due to invalid priority.\n";
+            return;
+        }
+        touchSlot(slot);
+        if (desc) {
+            // The old text stays in the arena until the next compaction.
+            if (textIndexBuilt) textIndex.remove(id, store.descriptions[slot]);
+            store.descriptionBytes -= store.descriptions[slot].size();
+            store.descriptions[slot] = store.text.intern(*desc);
+            store.descriptionBytes += store.descriptions[slot].size();
+            if (textIndexBuilt) textIndex.add(id, store.descriptions[slot]);
+        }
+        if (prio) {
+            if (sortedIndexesBuilt) priorityIndex.erase({ store.priorities[slot], id });
+            store.setPriority(slot, *prio);
+            if (sortedIndexesBuilt) priorityIndex.insert({ store.priorities[slot], id });
+        }
+        if (comp) {
+            if (dueBucketsBuilt) countInDueBucket(store.dueDates[slot], store.isCompleted(slot), false);
+            store.setCompleted(slot, *comp);
+            if (dueBucketsBuilt) countInDueBucket(store.dueDates[slot], *comp, true);
+        }
+        if (due) {
+            if (sortedIndexesBuilt) dueDateIndex.erase({ store.dueDates[slot], id });
+            if (dueBucketsBuilt) countInDueBucket(store.dueDates[slot], store.isCompleted(slot), false);
+            store.dueDates[slot] = *due;
+            if (sortedIndexesBuilt) dueDateIndex.insert({ store.dueDates[slot], id });
+            if (dueBucketsBuilt) countInDueBucket(store.dueDates[slot], store.isCompleted(slot), true);
+        }
+        if (comp || due) {
+            scheduleReminder(slot);
+        }
+        if (journalActive()) {
+            appendJournalRecord(updateRecord(id, desc, prio, comp, due));
+        }
+        // Text nothing points at is at least bytesStored - descriptionBytes
+        // (shared strings only make it more), so compacting here frees over
+        // half the arena and the cost stays amortized O(1) per byte.
+        if (desc && store.text.bytesStored() > 2 * store.descriptionBytes + deadTextSlackBytes) {
+            compactTasks();
+        }
+    }
+
+    /*-------------------------- TABLE RENDERING --------------------------*/
+
+    namespace
+    {
+        // Days since 1970-01-01 of a (proleptic Gregorian) calendar date.
+        int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+            year -= month <= 2;
+            int64_t era = (year >= 0 ? year : year - 399) / 400;
+            unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+            unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+            unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+            return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+        }
+
+        // Local calendar day of a time_t, cached per day so tables and the
+        // due-date buckets call localtime about once per distinct date.
+        // A cached day covers [first, last), kept an hour inside the day's
+        // real bounds, so a DST shift can never put a time on the wrong date.
+        class LocalDayCache {
+        public:
+            struct Day {
+                time_t first = 0;
+                time_t last = 0;
+                int64_t number = 0;  // days since 1970-01-01
+                char text[20] = {};  // YYYY-MM-DD
+            };
+
+            // nullptr if `when` has no local date.
+            const Day* find(time_t when) {
+                time_t key = when / 86400;
+                Day& cached = days[static_cast<size_t>(key < 0 ? -key : key) % cacheSize];
+                if (when < cached.first || when >= cached.last) {
+                    tm timeStruct{};
+#ifdef _WIN32
+                    // localtime_s returns 0 on success (MSVC).
+                    bool converted = localtime_s(&timeStruct, &when) == 0;
+#else
+                    bool converted = localtime_r(&when, &timeStruct) != nullptr;
+#endif
+                    if (!converted) {
+                        return nullptr;
+                    }
+                    strftime(cached.text, sizeof(cached.text), "%Y-%m-%d", &timeStruct);
+                    cached.number = daysFromCivil(timeStruct.tm_year + int64_t{ 1900 },
+                        static_cast<unsigned>(timeStruct.tm_mon + 1),
+                        static_cast<unsigned>(timeStruct.tm_mday));
+                    time_t sinceMidnight = timeStruct.tm_hour * 3600 + timeStruct.tm_min * 60
+                        + timeStruct.tm_sec;
+                    cached.first = when - std::max<time_t>(0, sinceMidnight - 3600);
+                    cached.last = when + std::max<time_t>(1, 86400 - sinceMidnight - 3600);
+                }
+                return &cached;
+            }
+
+        private:
+            static constexpr size_t cacheSize = 1024;
+            Day days[cacheSize];
+        };
+
+        // Buffered writer for the task table (displayTasks and the filters).
+        // Rows are formatted into one large buffer that goes out in a single
+        // write per batch, with the same columns std::setw produced:
+        // left-aligned, padded with spaces, never truncated.
+        class TableWriter {
+        public:
+            explicit TableWriter(std::ostream& stream) : out(stream) {
+                buffer.reserve(flushThreshold + 1024);
+            }
+            TableWriter(const TableWriter&) = delete;
+            TableWriter& operator=(const TableWriter&) = delete;
+            ~TableWriter() { flush(); }
+
+            void header() {
+                field("ID", 5);
+                field("Description", 25);
+                field("Priority", 10);
+                field("Status", 10);
+                field("Due Date", 20);
+                buffer += '\n';
+            }
+
+            void row(int id, std::string_view desc, uint8_t prio, bool completed, time_t due) {
+                char digits[16];
+                auto result = std::to_chars(digits, digits + sizeof(digits), id);
+                field(std::string_view(digits, static_cast<size_t>(result.ptr - digits)), 5);
+                field(desc, 25);
+                field(priorityName(prio), 10);
+                field(completed ? "Completed" : "Pending", 10);
+                field(formatDate(due), 20);
+                buffer += '\n';
+                if (buffer.size() >= flushThreshold) flush();
+            }
+
+            void flush() {
+                if (!buffer.empty()) {
+                    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                    buffer.clear();
+                }
+                out.flush();
+            }
+
+        private:
+            static constexpr size_t flushThreshold = 256 * 1024;
+
+            void field(std::string_view text, size_t width) {
+                buffer.append(text.data(), text.size());
+                if (text.size() < width) buffer.append(width - text.size(), ' ');
+            }
+
+            std::string_view formatDate(time_t due) {
+                const LocalDayCache::Day* day = dates.find(due);
+                return day ? std::string_view(day->text) : std::string_view("InvalidDate");
+            }
+
+            std::ostream& out;
+            std::string buffer;
+            LocalDayCache dates;
+        };
+    }
+
+    template <typename Table>
+    void TaskList::writeTaskRow(Table& table, size_t slot) {
+        table.row(store.ids[slot], store.descriptions[slot], store.priorities[slot],
+            store.isCompleted(slot), store.dueDates[slot]);
+    }
+
+    void TaskList::displayTasks() {
+        MYLIBRARY_TIME_OPERATION(Operation::Display);
+        StoreLock lock(*this);
+        if (store.size() == removedCount) {
+            std::cout << "No tasks available.\n";
+            return;
+        }
+
+        TableWriter table(std::cout);
+        table.header();
+        forEachInOrder([&table, this](size_t slot) { writeTaskRow(table, slot); });
+    }
+
+    // Sorting only switches the view; the index is already in order.
+    void TaskList::sortTasksByPriority(bool ascending) {
+        MYLIBRARY_TIME_OPERATION(Operation::SortByPriority);
+        StoreLock lock(*this);
+        if (!sortedIndexesBuilt) rebuildSortedIndexes();
+        sortOrder = SortOrder::Priority;
+        sortAscending = ascending;
+    }
+
+    void TaskList::sortTasksByDueDate(bool ascending) {
+        MYLIBRARY_TIME_OPERATION(Operation::SortByDueDate);
+        StoreLock lock(*this);
+        if (!sortedIndexesBuilt) rebuildSortedIndexes();
+        sortOrder = SortOrder::DueDate;
+        sortAscending = ascending;
+    }
+
+    void TaskList::filterTasksByStatus(bool completedStatus) {
+        MYLIBRARY_TIME_OPERATION(Operation::FilterByStatus);
+        StoreLock lock(*this);
+        bool foundAny = false;
+        TableWriter table(std::cout);
+        table.header();
+
+        auto printRow = [&foundAny, &table, this](size_t slot) {
+            foundAny = true;
+            writeTaskRow(table, slot);
+        };
+        if (sortOrder == SortOrder::Insertion) {
+            // Only the bitsets are read to find the matching slots.
+            auto matchingWord = [completedStatus, this](size_t word) {
+                return completedStatus ? store.completedBits[word]
+                    : store.liveBits[word] & ~store.completedBits[word];
+            };
+            size_t words = store.liveBits.size();
+            unsigned threads = parallelThreads(store.size());
+            if (threads > 1) {
+                auto lists = collectSlots(words, threads,
+                    [&matchingWord](size_t first, size_t last, std::vector<size_t>& slots) {
+                        forEachSetBit(first, last, matchingWord,
+                            [&slots](size_t slot) { slots.push_back(slot); });
+                    });
+                for (auto& slots : lists) {
+                    for (size_t slot : slots) printRow(slot);
+                }
+            }
+            else {
+                forEachSetBit(0, words, matchingWord, printRow);
+            }
+        }
+        else {
+            forEachInOrder([&](size_t slot) {
+                if (store.isCompleted(slot) == completedStatus) printRow(slot);
+            });
+        }
+        table.flush();
+        if (!foundAny) {
+            std::cout << "No tasks found with status: "
+                << (completedStatus ? "Completed" : "Pending") << std::endl;
+        }
+    }
+
+    void TaskList::filterTasksByPriority(Priority prio) {
+        MYLIBRARY_TIME_OPERATION(Operation::FilterByPriority);
+        StoreLock lock(*this);
+        bool foundAny = false;
+        TableWriter table(std::cout);
+        table.header();
+
+        auto printIfMatching = [&foundAny, &table, prio, this](size_t slot) {
+            if (store.priorities[slot] != prio) return;
+            foundAny = true;
+            writeTaskRow(table, slot);
+        };
+        if (sortOrder == SortOrder::Insertion) {
+            // Removed slots keep their old priority, hence the liveness check.
+            auto scan = [prio, this](size_t first, size_t last, auto&& visit) {
+                for (size_t slot = first; slot < last; ++slot) {
+                    if (store.priorities[slot] == prio && store.isLive(slot)) visit(slot);
+                }
+            };
+            unsigned threads = parallelThreads(store.size());
+            if (threads > 1) {
+                auto lists = collectSlots(store.liveBits.size(), threads,
+                    [&scan, this](size_t first, size_t last, std::vector<size_t>& slots) {
+                        scan(first * 64, std::min(last * 64, store.size()),
+                            [&slots](size_t slot) { slots.push_back(slot); });
+                    });
+                for (auto& slots : lists) {
+                    for (size_t slot : slots) printIfMatching(slot);
+                }
+            }
+            else {
+                scan(0, store.size(), printIfMatching);
+            }
+        }
+        else {
+            forEachInOrder(printIfMatching);
+        }
+        table.flush();
+        if (!foundAny) {
+            std::cout << "No tasks found with priority: " << priorityToString(prio) << std::endl;
+        }
+    }
+
+    void TaskList::displayCompletionPercentage() {
+        StoreLock lock(*this);
+        size_t liveCount = store.countLive();
+        if (liveCount == 0) {
+            std::cout << "No tasks. Completion percentage: 0%\n";
+            return;
+        }
+        size_t completedCount = store.countCompleted();
+        double percentage = (static_cast<double>(completedCount) / liveCount) * 100.0;
+        std::cout << "Completion Percentage: "
+            << std::fixed << std::setprecision(2) << percentage << "%\n";
+    }
+
+    /*------------------------------- SEARCH ------------------------------*/
+
+    void TaskList::buildTextIndex() {
+        textIndex.clear();
+        forEachSetBit(0, store.liveBits.size(), [this](size_t word) { return store.liveBits[word]; },
+            [this](size_t slot) { textIndex.add(store.ids[slot], store.descriptions[slot]); });
+        textIndexBuilt = true;
+    }
+
+    void TaskList::dropTextIndex() {
+        textIndex.clear();
+        textIndexBuilt = false;
+    }
+
+    std::vector<int> TaskList::searchTasks(std::string_view query) {
+        StoreLock lock(*this);
+        if (!textIndexBuilt) buildTextIndex();
+        return textIndex.search(query);
+    }
+
+    size_t TaskList::searchIndexBytes() {
+        StoreLock lock(*this);
+        return textIndex.postingBytes();
+    }
+
+    void TaskList::displaySearchResults(std::string_view query) {
+        StoreLock lock(*this);
+        std::vector<int> ids = searchTasks(query);
+        if (ids.empty()) {
+            std::cout << "No tasks found matching: " << query << std::endl;
+            return;
+        }
+        TableWriter table(std::cout);
+        table.header();
+        for (int id : ids) {
+            writeTaskRow(table, idIndex.find(id)->second);
+        }
+    }
+
+    /*------------------------------ QUERIES ------------------------------*/
+
+    namespace
+    {
+        // Puts matching slots in (key, id) order, or (key descending, id)
+        // order, keeping only the first `limit` (0: all). A small limit
+        // keeps a heap of the best so far; a large one partitions around
+        // the limit first and sorts just that prefix.
+        template <bool Ascending, typename Key>
+        void orderSlots(std::vector<size_t>& slots, const std::vector<Key>& keys,
+            const std::vector<int32_t>& ids, size_t limit) {
+            auto before = [&keys, &ids](size_t a, size_t b) {
+                if (keys[a] != keys[b]) return Ascending ? keys[a] < keys[b] : keys[a] > keys[b];
+                return ids[a] < ids[b];
+            };
+            if (limit == 0 || limit >= slots.size()) {
+                std::sort(slots.begin(), slots.end(), before);
+                return;
+            }
+            auto cut = slots.begin() + static_cast<std::ptrdiff_t>(limit);
+            if (limit <= 1024) {
+                std::partial_sort(slots.begin(), cut, slots.end(), before);
+            }
+            else {
+                std::nth_element(slots.begin(), cut, slots.end(), before);
+                std::sort(slots.begin(), cut, before);
+            }
+            slots.resize(limit);
+        }
+    }
+
+    // Every condition except completion, cheapest column first: completion
+    // has already been applied a bitset word at a time, and the substring
+    // search, the only one that reads the text, runs last.
+    bool TaskList::matchesQuery(const TaskQuery& query, size_t slot) {
+        uint8_t prio = store.priorities[slot];
+        if (query.priorityAtMost && prio > *query.priorityAtMost) return false;
+        if (query.priorityAtLeast && prio < *query.priorityAtLeast) return false;
+        time_t due = store.dueDates[slot];
+        if (query.dueFrom && due < *query.dueFrom) return false;
+        if (query.dueBefore && due >= *query.dueBefore) return false;
+        if (!query.descriptionContains.empty()
+            && store.descriptions[slot].find(query.descriptionContains) == std::string_view::npos) {
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<TaskRow> TaskList::runQuery(const TaskQuery& query) {
+        StoreLock lock(*this);
+        using Order = TaskQuery::Order;
+        std::vector<size_t> slots;
+
+        // Sorted and limited with the indexes already built: walk the
+        // index over the requested key range and stop at the limit.
+        bool useIndex = query.limit != 0 && sortedIndexesBuilt && query.orderBy != Order::Insertion;
+        if (useIndex) {
+            auto collect = [&query, &slots, this](int id) {
+                size_t slot = idIndex.find(id)->second;
+                if ((!query.completed || store.isCompleted(slot) == *query.completed)
+                    && matchesQuery(query, slot)) {
+                    slots.push_back(slot);
+                }
+                return slots.size() < query.limit;
+            };
+            constexpr int minId = std::numeric_limits<int>::min();
+            if (query.orderBy == Order::Priority) {
+                int low = query.priorityAtLeast ? static_cast<int>(*query.priorityAtLeast) : HIGHEST;
+                int high = query.priorityAtMost ? static_cast<int>(*query.priorityAtMost) : LOWEST;
+                auto first = priorityIndex.lower_bound({ low, minId });
+                auto last = low <= high ? priorityIndex.lower_bound({ high + 1, minId }) : first;
+                walkIndexRange(priorityIndex, first, last, query.ascending, collect);
+            }
+            else {
+                auto first = query.dueFrom ? dueDateIndex.lower_bound({ *query.dueFrom, minId })
+                    : dueDateIndex.begin();
+                auto last = query.dueBefore ? dueDateIndex.lower_bound({ *query.dueBefore, minId })
+                    : dueDateIndex.end();
+                if (query.dueFrom && query.dueBefore && *query.dueBefore < *query.dueFrom) last = first;
+                walkIndexRange(dueDateIndex, first, last, query.ascending, collect);
+            }
+        }
+        else {
+            // Column scan. Completion narrows each bitset word before any
+            // other column is read.
+            auto candidates = [&query, this](size_t word) {
+                uint64_t bits = store.liveBits[word];
+                if (query.completed) {
+                    bits &= *query.completed ? store.completedBits[word] : ~store.completedBits[word];
+                }
+                return bits;
+            };
+            // In insertion order a limit is the first matches: stop there.
+            size_t stopAt = query.orderBy == Order::Insertion && query.limit != 0
+                ? query.limit : std::numeric_limits<size_t>::max();
+            auto scan = [&query, &candidates, stopAt, this](size_t first, size_t last, std::vector<size_t>& out) {
+                for (size_t word = first; word < last && out.size() < stopAt; ++word) {
+                    forEachSetBit(word, word + 1, candidates, [&query, &out, this](size_t slot) {
+                        if (matchesQuery(query, slot)) out.push_back(slot);
+                    });
+                }
+            };
+            size_t words = store.liveBits.size();
+            unsigned threads = stopAt == std::numeric_limits<size_t>::max()
+                ? parallelThreads(store.size()) : 1;
+            if (threads > 1) {
+                for (auto& list : collectSlots(words, threads, scan)) {
+                    slots.insert(slots.end(), list.begin(), list.end());
+                }
+            }
+            else {
+                scan(0, words, slots);
+            }
+
+            if (query.orderBy == Order::Priority) {
+                if (query.ascending) orderSlots<true>(slots, store.priorities, store.ids, query.limit);
+                else orderSlots<false>(slots, store.priorities, store.ids, query.limit);
+            }
+            else if (query.orderBy == Order::DueDate) {
+                if (query.ascending) orderSlots<true>(slots, store.dueDates, store.ids, query.limit);
+                else orderSlots<false>(slots, store.dueDates, store.ids, query.limit);
+            }
+            if (query.limit != 0 && slots.size() > query.limit) {
+                slots.resize(query.limit);
+            }
+        }
+
+        std::vector<TaskRow> rows;
+        rows.reserve(slots.size());
+        for (size_t slot : slots) {
+            rows.push_back({ store.ids[slot], store.descriptions[slot],
+                static_cast<Priority>(store.priorities[slot]), store.isCompleted(slot),
+                store.dueDates[slot] });
+        }
+        return rows;
+    }
+
+    std::optional<TaskRow> TaskList::findTask(int id) {
+        StoreLock lock(*this);
+        auto it = idIndex.find(id);
+        if (it == idIndex.end()) {
+            return std::nullopt;
+        }
+        size_t slot = it->second;
+        return TaskRow{ id, store.descriptions[slot], static_cast<Priority>(store.priorities[slot]),
+            store.isCompleted(slot), store.dueDates[slot] };
+    }
+
+    /*------------------------------ CURSORS ------------------------------*/
+
+    namespace
+    {
+        // Steps through a (key, id) index in the order walkIndex uses: keys
+        // ascending or descending, equal keys always by ascending ID. Every
+        // step is O(1) amortized; in a descending view, crossing to another
+        // key steps back over a small group and searches past a large one.
+        // end() stands for "no such entry".
+        template <typename Key>
+        class IndexView {
+        public:
+            using Index = std::set<std::pair<Key, int>>;
+            using Iterator = typename Index::const_iterator;
+
+            IndexView(const Index& keyIndex, bool ascendingKeys) : index(keyIndex), ascending(ascendingKeys) {}
+
+            Iterator end() const { return index.end(); }
+
+            Iterator first() const {
+                if (ascending || index.empty()) return index.begin();
+                return groupStart(std::prev(index.end())->first);
+            }
+
+            Iterator last() const {
+                if (index.empty()) return index.end();
+                if (ascending) return std::prev(index.end());
+                return std::prev(index.upper_bound({ index.begin()->first, maxId }));
+            }
+
+            Iterator next(Iterator it) const {
+                Iterator following = std::next(it);
+                if (ascending || (following != index.end() && following->first == it->first)) return following;
+                Iterator group = groupStart(it);
+                return group == index.begin() ? index.end() : groupStart(std::prev(group));
+            }
+
+            Iterator previous(Iterator it) const {
+                if (ascending) return it == index.begin() ? index.end() : std::prev(it);
+                if (it != index.begin() && std::prev(it)->first == it->first) return std::prev(it);
+                Iterator group = index.upper_bound({ it->first, maxId });
+                return group == index.end() ? index.end() : std::prev(index.upper_bound({ group->first, maxId }));
+            }
+
+            // The first entry at or after (key, id) in view order.
+            Iterator seek(Key key, int id) const {
+                Iterator it = index.lower_bound({ key, id });
+                if (ascending || (it != index.end() && it->first == key)) return it;
+                Iterator group = groupStart(key);
+                return group == index.begin() ? index.end() : groupStart(std::prev(group));
+            }
+
+        private:
+            static constexpr int minId = std::numeric_limits<int>::min();
+            static constexpr int maxId = std::numeric_limits<int>::max();
+
+            Iterator groupStart(Key key) const { return index.lower_bound({ key, minId }); }
+
+            // The first entry with its key, stepping back a few entries
+            // before falling back to a search.
+            Iterator groupStart(Iterator it) const {
+                for (int steps = 0; steps < 8; ++steps) {
+                    if (it == index.begin() || std::prev(it)->first != it->first) return it;
+                    --it;
+                }
+                return groupStart(it->first);
+            }
+
+            const Index& index;
+            bool ascending;
+        };
+
+        // Up to `count` IDs from a sorted index for which matches(id) holds,
+        // walking forwards or backwards in view order from `from` (or from
+        // the start or end of the view).
+        template <typename Key, typename Match>
+        void walkIndexView(const IndexView<Key>& view, const std::optional<std::pair<Key, int>>& from,
+            bool inclusive, bool forward, size_t count, Match&& matches, std::vector<int>& ids) {
+            auto it = view.end();
+            if (!from) {
+                it = forward ? view.first() : view.last();
+            }
+            else {
+                it = view.seek(from->first, from->second);
+                bool atFrom = it != view.end() && *it == *from;
+                if (forward) {
+                    if (atFrom && !inclusive) it = view.next(it);
+                }
+                else if (it == view.end()) {
+                    it = view.last();  // everything comes before `from`
+                }
+                else if (!(atFrom && inclusive)) {
+                    it = view.previous(it);
+                }
+            }
+            for (; it != view.end() && ids.size() < count; it = forward ? view.next(it) : view.previous(it)) {
+                if (matches(it->second)) ids.push_back(it->second);
+            }
+        }
+    }
+
+    TaskCursor TaskList::openCursor(const TaskQuery& query, size_t pageSize) {
+        return TaskCursor(*this, query, std::max<size_t>(pageSize, 1));
+    }
+
+    bool TaskList::cursorMatches(const TaskCursor& cursor, size_t slot) {
+        const TaskQuery& query = cursor.query;
+        return store.isLive(slot) && (!query.completed || store.isCompleted(slot) == *query.completed)
+            && matchesQuery(query, slot);
+    }
+
+    TaskCursor::Position TaskList::cursorPosition(const TaskCursor& cursor, size_t slot) {
+        switch (cursor.query.orderBy) {
+        case TaskQuery::Order::Priority:
+            return { store.priorities[slot], store.ids[slot] };
+        case TaskQuery::Order::DueDate:
+            return { static_cast<int64_t>(store.dueDates[slot]), store.ids[slot] };
+        default:
+            return { static_cast<int64_t>(slot), store.ids[slot] };
+        }
+    }
+
+    // Appends up to `count` slots of the cursor's view, starting at `from`
+    // (skipping it unless `inclusive`) or at the start (forward) or end of
+    // the view. Backward walks come out in reverse view order.
+    void TaskList::walkCursor(const TaskCursor& cursor, const TaskCursor::Position* from, bool inclusive,
+        bool forward, size_t count, std::vector<size_t>& slots) {
+        const TaskQuery& query = cursor.query;
+        if (query.orderBy == TaskQuery::Order::Insertion) {
+            // A slot key from just before the last compaction is moved to
+            // where that slot went, or to the first slot after it if its task
+            // was gone (see compactedLiveBits). Older keys are re-found by ID;
+            // a task that has gone since then leaves nothing to go by, so the
+            // walk starts over.
+            bool upwards = forward == query.ascending;
+            size_t size = store.size();
+            size_t slot = upwards ? 0 : size - 1;
+            bool anchored = from != nullptr;
+            bool kept = true;  // the anchor task itself is still at `slot`
+            if (from && cursor.slotEpoch == slotEpoch) {
+                slot = static_cast<size_t>(from->key);
+            }
+            else if (from && cursor.slotEpoch + 1 == slotEpoch && !compactedLiveBits.empty()) {
+                size_t key = static_cast<size_t>(from->key);
+                slot = 0;
+                for (size_t word = 0; word < key / 64; ++word) {
+                    slot += std::bitset<64>(compactedLiveBits[word]).count();
+                }
+                uint64_t word = compactedLiveBits[key / 64];
+                slot += std::bitset<64>(word & ((uint64_t(1) << (key % 64)) - 1)).count();
+                kept = (word >> (key % 64)) & 1;
+            }
+            else if (from) {
+                auto it = idIndex.find(from->id);
+                anchored = it != idIndex.end();
+                if (anchored) slot = it->second;
+            }
+            if (anchored && !kept) {
+                if (!upwards) --slot;  // wraps past 0 to "done"
+            }
+            else if (anchored && !inclusive) {
+                slot = upwards ? slot + 1 : slot - 1;
+            }
+            for (; slot < size && slots.size() < count; slot = upwards ? slot + 1 : slot - 1) {
+                if (cursorMatches(cursor, slot)) slots.push_back(slot);
+            }
+            return;
+        }
+
+        if (!sortedIndexesBuilt) rebuildSortedIndexes();
+        std::vector<int> ids;
+        auto matches = [&cursor, this](int id) { return cursorMatches(cursor, idIndex.find(id)->second); };
+        if (query.orderBy == TaskQuery::Order::Priority) {
+            std::optional<std::pair<int, int>> key;
+            if (from) key = std::make_pair(static_cast<int>(from->key), from->id);
+            walkIndexView(IndexView<int>(priorityIndex, query.ascending), key, inclusive, forward, count, matches, ids);
+        }
+        else {
+            std::optional<std::pair<time_t, int>> key;
+            if (from) key = std::make_pair(static_cast<time_t>(from->key), from->id);
+            walkIndexView(IndexView<time_t>(dueDateIndex, query.ascending), key, inclusive, forward, count, matches, ids);
+        }
+        for (int id : ids) slots.push_back(idIndex.find(id)->second);
+    }
+
+    std::vector<TaskRow> TaskList::cursorPage(TaskCursor& cursor, TaskCursor::Move move, int id) {
+        using Move = TaskCursor::Move;
+        MYLIBRARY_TIME_OPERATION(Operation::Display);
+        StoreLock lock(*this);
+        size_t count = cursor.rowsPerPage;
+        std::vector<size_t> slots;
+        slots.reserve(count);
+
+        switch (move) {
+        case Move::Next:
+            walkCursor(cursor, cursor.started ? &cursor.last : nullptr, false, true, count, slots);
+            break;
+        case Move::Current:
+            walkCursor(cursor, cursor.started ? &cursor.first : nullptr, true, true, count, slots);
+            break;
+        case Move::Previous:
+            if (!cursor.started) break;
+            walkCursor(cursor, &cursor.first, false, false, count, slots);
+            std::reverse(slots.begin(), slots.end());
+            if (!slots.empty() && slots.size() < count) {
+                // Fewer than a page left before: show the first full page.
+                slots.clear();
+                walkCursor(cursor, nullptr, true, true, count, slots);
+            }
+            break;
+        case Move::Seek: {
+            auto it = idIndex.find(id);
+            if (it == idIndex.end() || !cursorMatches(cursor, it->second)) break;
+            TaskCursor::Position from = cursorPosition(cursor, it->second);
+            cursor.slotEpoch = slotEpoch;
+            walkCursor(cursor, &from, true, true, count, slots);
+            break;
+        }
+        }
+
+        std::vector<TaskRow> rows;
+        if (slots.empty()) return rows;
+        cursor.started = true;
+        cursor.first = cursorPosition(cursor, slots.front());
+        cursor.last = cursorPosition(cursor, slots.back());
+        cursor.slotEpoch = slotEpoch;
+        rows.reserve(slots.size());
+        for (size_t slot : slots) {
+            rows.push_back({ store.ids[slot], store.descriptions[slot],
+                static_cast<Priority>(store.priorities[slot]), store.isCompleted(slot),
+                store.dueDates[slot] });
+        }
+        return rows;
+    }
+
+    bool TaskList::cursorHasMore(TaskCursor& cursor, bool forward) {
+        StoreLock lock(*this);
+        std::vector<size_t> slots;
+        if (!cursor.started) {
+            // Before the first page, "next" is the first page.
+            if (forward) walkCursor(cursor, nullptr, true, true, 1, slots);
+        }
+        else {
+            walkCursor(cursor, forward ? &cursor.last : &cursor.first, false, forward, 1, slots);
+        }
+        return !slots.empty();
+    }
+
+    std::vector<TaskRow> TaskCursor::next() {
+        return list->cursorPage(*this, Move::Next);
+    }
+
+    std::vector<TaskRow> TaskCursor::previous() {
+        return list->cursorPage(*this, Move::Previous);
+    }
+
+    std::vector<TaskRow> TaskCursor::current() {
+        return list->cursorPage(*this, Move::Current);
+    }
+
+    std::vector<TaskRow> TaskCursor::seek(int id) {
+        return list->cursorPage(*this, Move::Seek, id);
+    }
+
+    bool TaskCursor::hasNext() {
+        return list->cursorHasMore(*this, true);
+    }
+
+    bool TaskCursor::hasPrevious() {
+        return list->cursorHasMore(*this, false);
+    }
+
+    void displayRows(const std::vector<TaskRow>& rows) {
+        TableWriter table(std::cout);
+        table.header();
+        for (const TaskRow& row : rows) {
+            table.row(row.id, row.description, static_cast<uint8_t>(row.priority), row.completed, row.dueDate);
+        }
+    }
+
+    /*------------------------------ DUE DATES ----------------------------*/
+
+    namespace
+    {
+        // Per thread, as lists may be used from several at once.
+        thread_local LocalDayCache dueDays;
+
+        // Bucket of a due date. Times without a local date sort before or
+        // after every real day.
+        int64_t dueDayOf(time_t due) {
+            if (const LocalDayCache::Day* day = dueDays.find(due)) return day->number;
+            return due < 0 ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max();
+        }
+
+        // First second of a local day (days since 1970-01-01).
+        time_t localMidnight(int64_t day) {
+            day += 719468;
+            int64_t era = (day >= 0 ? day : day - 146096) / 146097;
+            unsigned dayOfEra = static_cast<unsigned>(day - era * 146097);
+            unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+            unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+            unsigned monthIndex = (5 * dayOfYear + 2) / 153;
+            unsigned month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+            int64_t year = static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2);
+
+            tm timeStruct{};
+            timeStruct.tm_year = static_cast<int>(year - 1900);
+            timeStruct.tm_mon = static_cast<int>(month) - 1;
+            timeStruct.tm_mday = static_cast<int>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+            timeStruct.tm_isdst = -1;
+            return mktime(&timeStruct);
+        }
+
+        constexpr int openStart = std::numeric_limits<int>::min();
+        constexpr int openEnd = std::numeric_limits<int>::max();
+    }
+
+    void TaskList::countInDueBucket(time_t due, bool completed, bool add) {
+        int64_t day = dueDayOf(due);
+        if (!completed && day < overdueDay) {
+            overduePending = add ? overduePending + 1 : overduePending - 1;
+        }
+        auto bucket = dueBuckets.try_emplace(day).first;
+        size_t& count = completed ? bucket->second.completed : bucket->second.pending;
+        if (add) {
+            ++count;
+            return;
+        }
+        --count;
+        if (bucket->second.pending == 0 && bucket->second.completed == 0) {
+            dueBuckets.erase(bucket);
+        }
+    }
+
+    // Tasks are in insertion order, not date order, so the counts go
+    // through a hash map first and into the ordered map once per day.
+    void TaskList::buildDueBuckets() {
+        std::unordered_map<int64_t, DueCounts> byDay;
+        forEachSetBit(0, store.liveBits.size(), [this](size_t word) { return store.liveBits[word]; },
+            [&byDay, this](size_t slot) {
+                DueCounts& counts = byDay[dueDayOf(store.dueDates[slot])];
+                ++(store.isCompleted(slot) ? counts.completed : counts.pending);
+            });
+        std::vector<std::pair<int64_t, DueCounts>> days(byDay.begin(), byDay.end());
+        std::sort(days.begin(), days.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+        dueBuckets = std::map<int64_t, DueCounts>(days.begin(), days.end());
+        dueBucketsBuilt = true;
+        overdueDay = std::numeric_limits<int64_t>::min();
+    }
+
+    void TaskList::dropDueBuckets() {
+        dueBuckets.clear();
+        dueBucketsBuilt = false;
+        overdueDay = std::numeric_limits<int64_t>::min();
+    }
+
+    size_t TaskList::countOverdue() {
+        if (!dueBucketsBuilt) buildDueBuckets();
+        int64_t today = dueDayOf(time(nullptr));
+        if (today != overdueDay) {
+            overduePending = 0;
+            for (auto it = dueBuckets.begin(); it != dueBuckets.end() && it->first < today; ++it) {
+                overduePending += it->second.pending;
+            }
+            overdueDay = today;
+        }
+        return overduePending;
+    }
+
+    DueCounts TaskList::countDue(int fromDay, int toDay) {
+        StoreLock lock(*this);
+        if (!dueBucketsBuilt) buildDueBuckets();
+        DueCounts total;
+        if (fromDay >= toDay) return total;
+        int64_t today = dueDayOf(time(nullptr));
+        auto first = fromDay == openStart ? dueBuckets.begin() : dueBuckets.lower_bound(today + fromDay);
+        auto last = toDay == openEnd ? dueBuckets.end() : dueBuckets.lower_bound(today + toDay);
+        for (; first != last; ++first) {
+            total.pending += first->second.pending;
+            total.completed += first->second.completed;
+        }
+        return total;
+    }
+
+    std::vector<TaskRow> TaskList::tasksDue(int fromDay, int toDay, std::optional<bool> completed) {
+        StoreLock lock(*this);
+        std::vector<TaskRow> rows;
+        if (fromDay >= toDay) return rows;
+        if (!sortedIndexesBuilt) rebuildSortedIndexes();
+        int64_t today = dueDayOf(time(nullptr));
+        constexpr int minId = std::numeric_limits<int>::min();
+        auto first = fromDay == openStart ? dueDateIndex.begin()
+            : dueDateIndex.lower_bound({ localMidnight(today + fromDay), minId });
+        auto last = toDay == openEnd ? dueDateIndex.end()
+            : dueDateIndex.lower_bound({ localMidnight(today + toDay), minId });
+        for (; first != last; ++first) {
+            size_t slot = idIndex.find(first->second)->second;
+            if (completed && store.isCompleted(slot) != *completed) continue;
+            rows.push_back({ store.ids[slot], store.descriptions[slot],
+                static_cast<Priority>(store.priorities[slot]), store.isCompleted(slot),
+                store.dueDates[slot] });
+        }
+        return rows;
+    }
+
+    void TaskList::displayDueSummary(int soonDays) {
+        StoreLock lock(*this);
+        if (soonDays < 0) soonDays = 0;
+        DueCounts overdue = countDue(openStart, 0);
+        DueCounts soon = countDue(0, soonDays);
+        std::cout << "Overdue: " << overdue.pending << " pending\n"
+            << "Due in the next " << soonDays << " days: " << soon.pending << " pending, "
+            << soon.completed << " completed\n";
+        if (overdue.pending + soon.pending == 0) {
+            return;
+        }
+        TableWriter table(std::cout);
+        table.header();
+        for (const TaskRow& row : tasksDue(openStart, soonDays, false)) {
+            table.row(row.id, row.description, static_cast<uint8_t>(row.priority),
+                row.completed, row.dueDate);
+        }
+    }
+
+    /*----------------------------- STATISTICS ----------------------------*/
+
+    TaskStats TaskList::statistics() {
+        StoreLock lock(*this);
+        TaskStats stats;
+        for (size_t prio = 0; prio <= LOWEST; ++prio) {
+            stats.byPriority[prio] = store.liveByPriority[prio];
+            stats.completedByPriority[prio] = store.completedByPriority[prio];
+            stats.total += stats.byPriority[prio];
+            stats.completed += stats.completedByPriority[prio];
+        }
+        stats.overdue = countOverdue();
+#ifdef MYLIBRARY_VERIFY_STATS
+        // A full scan per call, so only in builds that ask for it.
+        verifyStatistics(stats);
+#endif
+        return stats;
+    }
+
+    // Recounts everything with a full scan of the store.
+    bool TaskList::verifyStatistics(const TaskStats& stats) {
+        TaskStats scanned;
+        int64_t today = dueDayOf(time(nullptr));
+        for (size_t slot = 0; slot < store.size(); ++slot) {
+            if (!store.isLive(slot)) continue;
+            size_t prio = priorityBucket(store.priorities[slot]);
+            bool completed = store.isCompleted(slot);
+            ++scanned.total;
+            ++scanned.byPriority[prio];
+            if (completed) {
+                ++scanned.completed;
+                ++scanned.completedByPriority[prio];
+            }
+            else if (dueDayOf(store.dueDates[slot]) < today) {
+                ++scanned.overdue;
+            }
+        }
+        bool matches = scanned.total == stats.total && scanned.completed == stats.completed
+            && scanned.overdue == stats.overdue && scanned.total == store.size() - removedCount
+            && std::equal(std::begin(scanned.byPriority), std::end(scanned.byPriority), stats.byPriority)
+            && std::equal(std::begin(scanned.completedByPriority), std::end(scanned.completedByPriority),
+                stats.completedByPriority);
+        if (!matches) {
+            std::cerr << "Warning: Task statistics do not match the task list.\n";
+        }
+        return matches;
+    }
+
+    void TaskList::displayStatistics() {
+        StoreLock lock(*this);
+        TaskStats stats = statistics();
+        std::cout << "Tasks: " << stats.total << " (" << stats.completed << " completed, "
+            << stats.total - stats.completed << " pending, " << stats.overdue << " overdue)\n";
+        for (int prio = HIGHEST; prio <= LOWEST; ++prio) {
+            std::cout << std::left << std::setw(10) << priorityName(prio) << std::right
+                << std::setw(10) << stats.byPriority[prio] << " tasks"
+                << std::setw(10) << stats.completedByPriority[prio] << " completed\n";
+        }
+        if (stats.byPriority[0] != 0) {
+            std::cout << std::left << std::setw(10) << priorityName(0) << std::right
+                << std::setw(10) << stats.byPriority[0] << " tasks"
+                << std::setw(10) << stats.completedByPriority[0] << " completed\n";
+        }
+    }
+
+    /*-------------------------- CONCURRENT ACCESS ------------------------*/
+
+    TaskList::StoreLock::StoreLock(TaskList& list)
+        : locked(list.concurrentAccess || list.autosave ? &list : nullptr)
+    {
+        if (!locked) return;
+        locked->storeMutex.lock();
+        ++locked->storeLockDepth;
+    }
+
+    TaskList::StoreLock::~StoreLock() {
+        if (!locked) return;
+        if (locked->storeLockDepth == 1 && locked->snapshotStale()) {
+            if (locked->concurrentAccess) locked->publishSnapshot();
+            if (locked->autosave) locked->scheduleAutosave();
+        }
+        --locked->storeLockDepth;
+        locked->storeMutex.unlock();
+    }
+
+    void TaskList::touchSlot(size_t slot) {
+        size_t chunk = slot / TaskSnapshot::chunkSlots;
+        if (chunk / 64 >= dirtyChunks.size()) dirtyChunks.resize(chunk / 64 + 1, 0);
+        dirtyChunks[chunk / 64] |= uint64_t(1) << (chunk % 64);
+    }
+
+    // Slots were moved or replaced wholesale (load, compaction).
+    void TaskList::touchAllSlots() {
+        allChunksDirty = true;
+        ++slotEpoch;
+        compactedLiveBits.clear();
+    }
+
+    bool TaskList::snapshotStale() {
+        std::shared_ptr<const TaskSnapshot> current = std::atomic_load(&publishedSnapshot);
+        return !current || allChunksDirty || current->slots != store.size()
+            || std::any_of(dirtyChunks.begin(), dirtyChunks.end(), [](uint64_t word) { return word != 0; });
+    }
+
+    // Copies the touched chunks and the ones past the previous version's
+    // end; every other chunk is shared with the previous version. The new
+    // version also holds the arena's blocks, which covers every view in
+    // the shared chunks too: the arena only ever appends, except when it
+    // is replaced wholesale, and then every chunk is copied.
+    void TaskList::publishSnapshot() {
+        constexpr size_t chunkSlots = TaskSnapshot::chunkSlots;
+        std::shared_ptr<const TaskSnapshot> previous = std::atomic_load(&publishedSnapshot);
+        size_t previousSlots = previous && !allChunksDirty ? previous->slots : 0;
+        size_t slots = store.size();
+
+        auto next = std::make_shared<TaskSnapshot>();
+        next->chunks.reserve((slots + chunkSlots - 1) / chunkSlots);
+        for (size_t first = 0; first < slots; first += chunkSlots) {
+            size_t chunk = first / chunkSlots;
+            size_t last = std::min(first + chunkSlots, slots);
+            bool touched = chunk / 64 < dirtyChunks.size() && ((dirtyChunks[chunk / 64] >> (chunk % 64)) & 1);
+            if (!touched && last <= previousSlots) {
+                next->chunks.push_back(previous->chunks[chunk]);
+                continue;
+            }
+            auto copy = std::make_shared<TaskSnapshot::Chunk>();
+            copy->ids.assign(store.ids.data() + first, store.ids.data() + last);
+            copy->priorities.assign(store.priorities.data() + first, store.priorities.data() + last);
+            copy->dueDates.assign(store.dueDates.data() + first, store.dueDates.data() + last);
+            copy->descriptions.assign(store.descriptions.data() + first, store.descriptions.data() + last);
+            size_t words = (last - first + 63) / 64;
+            std::copy_n(store.completedBits.data() + first / 64, words, copy->completedBits);
+            std::copy_n(store.liveBits.data() + first / 64, words, copy->liveBits);
+            next->chunks.push_back(std::move(copy));
+        }
+        next->textBlocks = store.text.sharedBlocks();
+        next->slots = slots;
+        next->liveCount = slots - removedCount;
+        next->snapshotVersion = previous ? previous->snapshotVersion + 1 : 1;
+
+        std::atomic_store(&publishedSnapshot, std::shared_ptr<const TaskSnapshot>(std::move(next)));
+        std::fill(dirtyChunks.begin(), dirtyChunks.end(), 0);
+        allChunksDirty = false;
+    }
+
+    void TaskList::setConcurrentAccess(bool enabled) {
+        if (enabled && !concurrentAccess) {
+            publishSnapshot();  // so readers have a version from the start
+        }
+        concurrentAccess = enabled;
+    }
+
+    std::shared_ptr<const TaskSnapshot> TaskList::snapshot() {
+        if (!concurrentAccess) {
+            StoreLock lock(*this);  // the autosave worker may publish too
+            if (snapshotStale()) publishSnapshot();
+        }
+        return std::atomic_load(&publishedSnapshot);
+    }
+
+    void TaskList::writeBatch(const std::function<void()>& edits) {
+        StoreLock lock(*this);
+        edits();
+    }
+
+    std::vector<TaskRow> TaskSnapshot::filterByStatus(bool completedStatus) const {
+        std::vector<TaskRow> rows;
+        forEach([&rows, completedStatus](const TaskRow& row) {
+            if (row.completed == completedStatus) rows.push_back(row);
+        });
+        return rows;
+    }
+
+    void TaskSnapshot::display(std::ostream& out) const {
+        if (liveCount == 0) {
+            out << "No tasks available.\n";
+            return;
+        }
+        TableWriter table(out);
+        table.header();
+        forEach([&table](const TaskRow& row) {
+            table.row(row.id, row.description, static_cast<uint8_t>(row.priority),
+                row.completed, row.dueDate);
+        });
+    }
+
+    /*----------------------- WRITE-AHEAD JOURNAL -------------------------*/
+
+    // Order-sensitive hash of everything a snapshot in `format` persists.
+    // A journal's Base records carry it so replay can tell which snapshot
+    // they follow; text snapshots leave out what writeTextRecords skips.
+    uint64_t TaskList::contentFingerprint(const TaskStore& list, FileFormat format) {
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const void* data, size_t length) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < length; ++i) {
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            }
+        };
+        for (size_t slot = 0; slot < list.size(); ++slot) {
+            if (!list.isLive(slot)) continue;
+            std::string_view desc = list.descriptions[slot];
+            if (format == FileFormat::Text && !fitsTextRecord(desc)) continue;
+            uint64_t length = desc.size();
+            int64_t due = static_cast<int64_t>(list.dueDates[slot]);
+            uint8_t fields[2] = { list.priorities[slot], list.isCompleted(slot) ? uint8_t(1) : uint8_t(0) };
+            mix(&length, sizeof(length));
+            mix(desc.data(), desc.size());
+            mix(fields, sizeof(fields));
+            mix(&due, sizeof(due));
+        }
+        return hash;
+    }
+
+    // Snapshots carry their IDs now, so the Base only needs nextId (which
+    // keeps IDs of deleted tasks from being handed out again).
+    std::string TaskList::journalBaseRecord(uint64_t fingerprint, int baseNextId) {
+        std::string payload;
+        putValue<uint8_t>(payload, JournalBase);
+        putValue<uint64_t>(payload, fingerprint);
+        putValue<int32_t>(payload, baseNextId);
+        putValue<uint32_t>(payload, 0);
+        return frameRecord(payload);
+    }
+
+    // Older journals also list the live IDs, written back in snapshot order.
+    void TaskList::applyJournalBase(const char* pos, const char* end) {
+        int32_t baseNextId = 0;
+        uint32_t count = 0;
+        if (!getValue(pos, end, baseNextId) || !getValue(pos, end, count)) return;
+        nextId = std::max(nextId, static_cast<int>(baseNextId));
+        if (count == 0) return;
+        if (count != store.size() - removedCount
+            || static_cast<size_t>(end - pos) < count * sizeof(int32_t)) {
+            std::cerr << "Warning: Journal task count does not match the snapshot.\n";
+            return;
+        }
+        for (size_t slot = 0; slot < store.size(); ++slot) {
+            if (store.isLive(slot)) getValue(pos, end, store.ids[slot]);
+        }
+        rebuildIndex();
+        dropSortedIndexes();
+        dropTextIndex();
+        if (reminders) reminders->stale = true;
+        touchAllSlots();
+    }
+
+    // Replays the records that follow the last Base matching `fingerprint`.
+    // Returns false if no Base matches, i.e. the journal belongs to some
+    // other snapshot.
+    bool TaskList::replayJournal(const char* begin, const char* end, uint64_t fingerprint,
+        size_t& baseOffset, size_t& validLength)
+    {
+        if (static_cast<size_t>(end - begin) < journalHeaderSize
+            || memcmp(begin, journalMagic, sizeof(journalMagic)) != 0) {
+            std::cerr << "Warning: Journal header is missing or corrupt.\n";
+            return false;
+        }
+
+        // Pass 1: walk the frames to find the valid prefix and the Base to start at.
+        const char* pos = begin + journalHeaderSize;
+        const char* start = nullptr;
+        while (static_cast<size_t>(end - pos) >= journalFrameSize) {
+            uint32_t length = 0;
+            uint32_t checksum = 0;
+            memcpy(&length, pos, sizeof(length));
+            memcpy(&checksum, pos + sizeof(length), sizeof(checksum));
+            const char* payload = pos + journalFrameSize;
+            if (length == 0 || static_cast<size_t>(end - payload) < length
+                || checksum32(payload, length) != checksum) {
+                break;
+            }
+            uint64_t baseFingerprint = 0;
+            const char* field = payload + 1;
+            if (static_cast<uint8_t>(*payload) == JournalBase
+                && getValue(field, payload + length, baseFingerprint)
+                && baseFingerprint == fingerprint) {
+                start = pos;
+            }
+            pos = payload + length;
+        }
+        validLength = static_cast<size_t>(pos - begin);
+        if (pos != end) {
+            std::cerr << "Warning: Ignoring a torn record at the end of the journal.\n";
+        }
+        if (!start) {
+            return false;
+        }
+        baseOffset = static_cast<size_t>(start - begin);
+
+        // Pass 2: apply from that Base onwards.
+        for (pos = start; pos != begin + validLength; ) {
+            uint32_t length = 0;
+            memcpy(&length, pos, sizeof(length));
+            const char* field = pos + journalFrameSize;
+            const char* recordEnd = field + length;
+            pos = recordEnd;
+
+            uint8_t type = static_cast<uint8_t>(*field++);
+            int32_t id = 0;
+            switch (type) {
+            case JournalBase: {
+                uint64_t baseFingerprint = 0;
+                getValue(field, recordEnd, baseFingerprint);
+                applyJournalBase(field, recordEnd);
+                break;
+            }
+            case JournalAdd: {
+                uint8_t prio = 0;
+                int64_t due = 0;
+                std::string_view desc;
+                if (!getValue(field, recordEnd, id) || !getValue(field, recordEnd, prio)
+                    || !getValue(field, recordEnd, due) || !getString(field, recordEnd, desc)
+                    || prio < HIGHEST || prio > LOWEST || idIndex.count(id)) {
+                    std::cerr << "Warning: Skipping invalid journal record.\n";
+                    break;
+                }
+                idIndex[id] = store.size();
+                store.push(id, desc, static_cast<Priority>(prio), false,
+                    static_cast<time_t>(due));
+                indexTask(store.size() - 1);
+                nextId = std::max(nextId, id + 1);
+                break;
+            }
+            case JournalUpdate: {
+                uint8_t fields = 0;
+                std::optional<std::string> desc;
+                std::optional<Priority> prio;
+                std::optional<bool> comp;
+                std::optional<time_t> due;
+                bool ok = getValue(field, recordEnd, id) && getValue(field, recordEnd, fields);
+                if (ok && (fields & UpdateDescription)) {
+                    std::string value;
+                    ok = getString(field, recordEnd, value);
+                    desc = std::move(value);
+                }
+                if (ok && (fields & UpdatePriority)) {
+                    uint8_t value = 0;
+                    ok = getValue(field, recordEnd, value);
+                    prio = static_cast<Priority>(value);
+                }
+                if (ok && (fields & UpdateCompleted)) {
+                    uint8_t value = 0;
+                    ok = getValue(field, recordEnd, value);
+                    comp = value != 0;
+                }
+                if (ok && (fields & UpdateDueDate)) {
+                    int64_t value = 0;
+                    ok = getValue(field, recordEnd, value);
+                    due = static_cast<time_t>(value);
+                }
+                if (!ok) {
+                    std::cerr << "Warning: Skipping invalid journal record.\n";
+                    break;
+                }
+                updateTask(id, desc, prio, comp, due);
+                break;
+            }
+            case JournalDelete:
+                if (getValue(field, recordEnd, id)) {
+                    deleteTask(id);
+                }
+                break;
+            default:
+                std::cerr << "Warning: Skipping unknown journal record.\n";
+                break;
+            }
+        }
+        return true;
+    }
+
+    bool TaskList::journalActive() const {
+        return journal->open && !journal->replaying;
+    }
+
+    // Atomically replace the journal with header + body.
+    bool TaskList::replaceJournal(const std::string& body) {
+        std::string tempFile = journal->journalFile + ".tmp";
+        FILE* file = fopen(tempFile.c_str(), "wb");
+        if (!file) return false;
+        std::string header(journalMagic, sizeof(journalMagic));
+        putValue<uint32_t>(header, journalVersion);
+        bool ok = fwrite(header.data(), 1, header.size(), file) == header.size()
+            && fwrite(body.data(), 1, body.size(), file) == body.size()
+            && syncToDisk(file);
+        fclose(file);
+        if (ok) countBytesWritten(header.size() + body.size());
+        std::error_code ec;
+        if (ok) std::filesystem::rename(tempFile, journal->journalFile, ec);
+        if (!ok || ec) {
+            std::filesystem::remove(tempFile, ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool TaskList::reopenJournalForAppend() {
+        journal->out = fopen(journal->journalFile.c_str(), "ab");
+        if (!journal->out) {
+            std::cerr << "Error: Unable to open journal " << journal->journalFile << ".\n";
+            return false;
+        }
+        std::error_code ec;
+        journal->bytes = static_cast<size_t>(std::filesystem::file_size(journal->journalFile, ec));
+        journal->unsynced = 0;
+        return true;
+    }
+
+    void TaskList::openJournal(const std::string& snapshotFile, JournalOptions options) {
+        MYLIBRARY_TIME_OPERATION(Operation::Load);
+        StoreLock lock(*this);
+        closeJournal();
+        journal->snapshotFile = snapshotFile;
+        journal->journalFile = snapshotFile + ".wal";
+        journal->format = formatForFile(snapshotFile);
+        journal->options = options;
+        journal->compactAt = options.compactThresholdBytes;
+
+        // A compaction that died before its rename leaves a temp file; the
+        // old snapshot plus the journal are still the authoritative state.
+        std::error_code ec;
+        std::filesystem::remove(snapshotFile + ".tmp", ec);
+
+        loadTasksFromFile(snapshotFile);
+        uint64_t fingerprint = contentFingerprint(store, journal->format);
+
+        bool matched = false;
+        bool exists = false;
+        size_t baseOffset = 0;
+        size_t validLength = 0;
+        size_t journalSize = 0;
+        {
+            MappedFile file;
+            if (file.open(journal->journalFile)) {
+                exists = true;
+                journalSize = file.size();
+                journal->replaying = true;
+                matched = replayJournal(file.begin(), file.end(), fingerprint, baseOffset, validLength);
+                journal->replaying = false;
+            }
+        }
+
+        bool ok = true;
+        if (!matched) {
+            if (exists) {
+                std::string rejected = journal->journalFile + ".rejected";
+                std::cerr << "Warning: Journal does not match " << snapshotFile
+                    << "; moved it to " << rejected << ".\n";
+                std::filesystem::rename(journal->journalFile, rejected, ec);
+            }
+            ok = replaceJournal(journalBaseRecord(fingerprint, nextId));
+        }
+        else if (baseOffset != journalHeaderSize || validLength != journalSize) {
+            // Either a compaction landed before the journal was cut back, or
+            // the tail was torn: keep only the records replay actually used.
+            std::ifstream in(journal->journalFile, std::ios::binary);
+            std::string body(validLength - baseOffset, '\0');
+            in.seekg(static_cast<std::streamoff>(baseOffset));
+            in.read(&body[0], static_cast<std::streamsize>(body.size()));
+            ok = in.good() && replaceJournal(body);
+        }
+        if (!ok || !reopenJournalForAppend()) {
+            std::cerr << "Error: Journal disabled; changes must be saved manually.\n";
+            return;
+        }
+        journal->open = true;
+    }
+
+    // openJournal's load and replay without its repairs: a journal that
+    // does not match, a torn tail or a leftover temp file stay as they are.
+    void TaskList::loadJournaledTasks(const std::string& snapshotFile) {
+        MYLIBRARY_TIME_OPERATION(Operation::Load);
+        StoreLock lock(*this);
+        closeJournal();
+        loadTasksFromFile(snapshotFile);
+        MappedFile file;
+        if (!file.open(snapshotFile + ".wal")) return;
+        uint64_t fingerprint = contentFingerprint(store, formatForFile(snapshotFile));
+        size_t baseOffset = 0;
+        size_t validLength = 0;
+        if (!replayJournal(file.begin(), file.end(), fingerprint, baseOffset, validLength)) {
+            std::cerr << "Warning: Journal does not match " << snapshotFile << "; ignored it.\n";
+        }
+    }
+
+    bool TaskList::journalCoversSnapshot(const std::string& filename) {
+        return journal->open && filename == journal->snapshotFile;
+    }
+
+    void TaskList::appendJournalRecord(const std::string& record) {
+        finishCompaction(false);
+        if (!journal->out) return;
+        if (fwrite(record.data(), 1, record.size(), journal->out) != record.size()) {
+            std::cerr << "Error: Unable to append to journal.\n";
+            return;
+        }
+        journal->bytes += record.size();
+        countBytesWritten(record.size());
+        if (++journal->unsynced >= journal->options.syncEveryRecords) {
+            syncJournal();
+        }
+        if (journal->bytes >= journal->compactAt && !journal->compacting) {
+            beginCompaction();
+        }
+    }
+
+    void TaskList::syncJournal() {
+        StoreLock lock(*this);
+        if (!journal->out || journal->unsynced == 0) return;
+        if (!syncToDisk(journal->out)) {
+            std::cerr << "Error: Unable to sync journal to disk.\n";
+        }
+        journal->unsynced = 0;
+    }
+
+    // Capture the live tasks, log a Base record for them and let a worker
+    // thread write them out as the new snapshot. Mutations keep appending
+    // to the journal meanwhile.
+    void TaskList::beginCompaction() {
+        if (!journal->out) return;
+        TaskStore snapshot = store.liveCopy();
+        uint64_t fingerprint = contentFingerprint(snapshot, journal->format);
+        int snapshotNextId = nextId;
+
+        // The Base has to be durable before the snapshot can replace the old one.
+        std::string base = journalBaseRecord(fingerprint, snapshotNextId);
+        if (fwrite(base.data(), 1, base.size(), journal->out) != base.size()) {
+            std::cerr << "Error: Unable to append to journal.\n";
+            return;
+        }
+        journal->baseOffset = journal->bytes;
+        journal->bytes += base.size();
+        countBytesWritten(base.size());
+        ++journal->unsynced;
+        syncJournal();
+
+        journal->compacting = true;
+        journal->workerDone.store(false);
+        journal->worker = std::thread([state = journal.get(), snapshot = std::move(snapshot), snapshotNextId]() {
+            state->workerOk = replaceTasksFile(state->snapshotFile, state->format, snapshot, snapshotNextId);
+            state->workerDone.store(true, std::memory_order_release);
+        });
+    }
+
+    // Once the new snapshot is in place, drop the journal prefix it covers.
+    void TaskList::finishCompaction(bool wait) {
+        if (!journal->compacting) return;
+        if (!wait && !journal->workerDone.load(std::memory_order_acquire)) return;
+        journal->worker.join();
+        journal->compacting = false;
+
+        if (!journal->workerOk) {
+            std::cerr << "Warning: Journal compaction failed; the journal keeps growing.\n";
+            journal->compactAt = journal->bytes + journal->options.compactThresholdBytes;
+            return;
+        }
+
+        syncJournal();
+        fclose(journal->out);
+        journal->out = nullptr;
+        std::ifstream in(journal->journalFile, std::ios::binary);
+        std::string body(journal->bytes - journal->baseOffset, '\0');
+        in.seekg(static_cast<std::streamoff>(journal->baseOffset));
+        in.read(&body[0], static_cast<std::streamsize>(body.size()));
+        bool readOk = in.good();
+        in.close();
+        if (!readOk) {
+            std::cerr << "Error: Unable to read back the journal.\n";
+        }
+        else if (!replaceJournal(body)) {
+            std::cerr << "Error: Unable to rewrite the journal.\n";
+        }
+        // Even if the cut failed, the full journal replays correctly.
+        reopenJournalForAppend();
+        journal->compactAt = journal->bytes + journal->options.compactThresholdBytes;
+    }
+
+    void TaskList::compactJournal() {
+        StoreLock lock(*this);
+        if (!journal->open) return;
+        finishCompaction(true);
+        beginCompaction();
+        finishCompaction(true);
+    }
+
+    // Folds the journal into the snapshot first, so whatever reads the
+    // snapshot next (a converter, autosave, another tool) sees every edit.
+    // The journal file is only removed once it is down to its Base record.
+    void TaskList::closeJournal(bool removeFile) {
+        StoreLock lock(*this);
+        if (!journal->open) return;
+        const size_t foldedBytes = journalHeaderSize + journalBaseRecord(0, 0).size();
+        finishCompaction(true);
+        if (journal->bytes > foldedBytes) {
+            beginCompaction();
+            finishCompaction(true);
+        }
+        syncJournal();
+        if (journal->out) fclose(journal->out);
+        journal->out = nullptr;
+        journal->open = false;
+        if (removeFile && journal->bytes <= foldedBytes) {
+            std::error_code ec;
+            std::filesystem::remove(journal->journalFile, ec);
+        }
+    }
+
+    /*------------------------------ AUTOSAVE -----------------------------*/
+
+    // Autosave rides on the snapshot machinery: the store lock (taken by
+    // every operation while autosave is on) wakes the worker after a
+    // change, and the worker publishes a snapshot, which only copies the
+    // chunks touched since the last one, and writes that out unlocked.
+    void TaskList::startAutosave(const std::string& filename, AutosaveOptions options) {
+        stopAutosave();
+        if (journalCoversSnapshot(filename)) {
+            std::cerr << "Error: " << filename << " is journaled; autosave not started.\n";
+            return;
+        }
+        std::error_code ec;
+        if (std::filesystem::exists(filename + ".wal", ec)) {
+            // Rewriting the file would orphan the journal's edits.
+            std::cerr << "Error: " << filename << " has a journal; autosave not started.\n";
+            return;
+        }
+        if (options.format == FileFormat::Auto) {
+            options.format = formatForFile(filename);
+        }
+        std::filesystem::remove(filename + ".tmp", ec);  // left by a crash mid-write
+
+        // From here on a stale snapshot means an unsaved change.
+        if (snapshotStale()) publishSnapshot();
+        autosave = std::make_unique<AutosaveState>();
+        autosave->filename = filename;
+        autosave->options = options;
+        autosave->worker = std::thread([this]() { runAutosave(); });
+    }
+
+    // Called with the store lock held, after a change.
+    void TaskList::scheduleAutosave() {
+        std::lock_guard<std::mutex> guard(autosave->mutex);
+        if (autosave->pending) return;
+        autosave->pending = true;
+        autosave->wake.notify_one();
+    }
+
+    void TaskList::runAutosave() {
+        AutosaveState& state = *autosave;
+        std::unique_lock<std::mutex> guard(state.mutex);
+        for (;;) {
+            state.wake.wait(guard, [&state]() { return state.pending || state.stopping; });
+            if (!state.pending) break;
+            // Let further changes pile up into this write.
+            state.wake.wait_for(guard, std::chrono::milliseconds(state.options.delayMs),
+                [&state]() { return state.flushing || state.stopping; });
+            guard.unlock();
+
+            std::shared_ptr<const TaskSnapshot> version;
+            int versionNextId = 0;
+            {
+                std::lock_guard<std::recursive_mutex> storeGuard(storeMutex);
+                if (snapshotStale()) publishSnapshot();
+                version = std::atomic_load(&publishedSnapshot);
+                versionNextId = nextId;
+                std::lock_guard<std::mutex> flags(state.mutex);
+                state.pending = false;
+                state.writing = true;
+            }
+
+            // The rows' descriptions stay in the snapshot's text blocks.
+            TaskStore rows;
+            rows.reserve(version->size());
+            version->forEach([&rows](const TaskRow& row) {
+                rows.pushShared(row.id, row.description, row.priority, row.completed, row.dueDate);
+            });
+            bool ok = replaceTasksFile(state.filename, state.options.format, rows, versionNextId);
+            if (!ok) {
+                std::cerr << "Error: Autosave to " << state.filename << " failed; retrying after the next change.\n";
+            }
+
+            guard.lock();
+            state.writing = false;
+            if (ok) ++state.writes;
+            state.written.notify_all();
+        }
+    }
+
+    void TaskList::flushAutosave() {
+        if (!autosave) return;
+        AutosaveState& state = *autosave;
+        std::unique_lock<std::mutex> guard(state.mutex);
+        state.flushing = true;
+        state.wake.notify_one();
+        state.written.wait(guard, [&state]() { return !state.pending && !state.writing; });
+        state.flushing = false;
+    }
+
+    void TaskList::stopAutosave() {
+        if (!autosave) return;
+        flushAutosave();
+        {
+            std::lock_guard<std::mutex> guard(autosave->mutex);
+            autosave->stopping = true;
+        }
+        autosave->wake.notify_one();
+        autosave->worker.join();
+        autosave.reset();
+    }
+
+    size_t TaskList::autosaveWrites() {
+        if (!autosave) return 0;
+        std::lock_guard<std::mutex> guard(autosave->mutex);
+        return autosave->writes;
+    }
+
+    /*------------------------------ REMINDERS ----------------------------*/
+
+    namespace
+    {
+        // A task's reminder time, clamped instead of wrapping for dates near
+        // the ends of time_t.
+        time_t reminderTime(time_t due, time_t leadSeconds) {
+            if (leadSeconds > 0 && due < std::numeric_limits<time_t>::min() + leadSeconds) {
+                return std::numeric_limits<time_t>::min();
+            }
+            return due - leadSeconds;
+        }
+    }
+
+    void TaskList::startReminders(std::function<void(const TaskRow&)> onDue, ReminderOptions options) {
+        StoreLock lock(*this);
+        if (!options.clock) {
+            options.clock = [] { return std::time(nullptr); };
+        }
+        time_t now = options.clock();
+        reminders = std::make_unique<ReminderState>(std::move(onDue), std::move(options), now);
+        rescheduleReminders();
+    }
+
+    void TaskList::stopReminders() {
+        StoreLock lock(*this);
+        reminders.reset();
+    }
+
+    size_t TaskList::scheduledReminders() {
+        StoreLock lock(*this);
+        if (!reminders) return 0;
+        if (reminders->stale) rescheduleReminders();
+        return reminders->wheel.size();
+    }
+
+    size_t TaskList::pollReminders() {
+        std::vector<int> due;
+        std::function<void(const TaskRow&)> onDue;
+        time_t now = 0;
+        time_t lead = 0;
+        {
+            StoreLock lock(*this);
+            if (!reminders) return 0;
+            if (reminders->stale) rescheduleReminders();
+            now = reminders->options.clock();
+            lead = reminders->options.leadSeconds;
+            reminders->wheel.advance(now, due);
+            onDue = reminders->onDue;
+        }
+        // Each row is looked up just before its call, so earlier callbacks
+        // may have edited the list; tasks they completed, deleted or moved
+        // to a later date are skipped.
+        size_t fired = 0;
+        for (int id : due) {
+            std::optional<TaskRow> task = findTask(id);
+            if (!task || task->completed || reminderTime(task->dueDate, lead) > now) continue;
+            {
+                StoreLock lock(*this);
+                cancelReminder(id);  // set again by an earlier callback's edit
+            }
+            if (onDue) onDue(*task);
+            ++fired;
+        }
+        return fired;
+    }
+
+    void TaskList::scheduleReminder(size_t slot) {
+        if (!reminders || reminders->stale) return;
+        if (store.isCompleted(slot)) {
+            reminders->wheel.cancel(store.ids[slot]);
+        }
+        else {
+            reminders->wheel.schedule(store.ids[slot],
+                reminderTime(store.dueDates[slot], reminders->options.leadSeconds));
+        }
+    }
+
+    void TaskList::cancelReminder(int id) {
+        if (!reminders || reminders->stale) return;
+        reminders->wheel.cancel(id);
+    }
+
+    // Every pending task whose reminder time is still ahead, on a fresh
+    // wheel at the current time.
+    void TaskList::rescheduleReminders() {
+        time_t now = reminders->options.clock();
+        time_t lead = reminders->options.leadSeconds;
+        reminders->wheel = TimerWheel(now);
+        for (size_t slot = 0; slot < store.size(); ++slot) {
+            if (!store.isLive(slot) || store.isCompleted(slot)) continue;
+            time_t when = reminderTime(store.dueDates[slot], lead);
+            if (when > now) reminders->wheel.schedule(store.ids[slot], when);
+        }
+        reminders->stale = false;
+    }
+
+    /*---------------------------- DEFAULT LIST ---------------------------*/
+
+    TaskList& Task::defaultList() {
+        static TaskList list;
+        return list;
+    }
+
+    void Task::loadTasksFromFile(const std::string& filename, FileFormat format, LoadOptions options) {
+        defaultList().loadTasksFromFile(filename, format, options);
+    }
+
+    void Task::saveTasksToFile(const std::string& filename, FileFormat format) {
+        defaultList().saveTasksToFile(filename, format);
+    }
+
+    int Task::addTask(const std::string& desc, Priority prio, time_t due) {
+        return defaultList().addTask(desc, prio, due);
+    }
+
+    void Task::deleteTask(int id) {
+        defaultList().deleteTask(id);
+    }
+
+    void Task::updateTask(int id,
+        std::optional<std::string> desc,
+        std::optional<Priority> prio,
+        std::optional<bool> comp,
+        std::optional<time_t> due)
+    {
+        defaultList().updateTask(id, std::move(desc), prio, comp, due);
+    }
+
+    void Task::displayTasks() {
+        defaultList().displayTasks();
+    }
+
+    void Task::sortTasksByPriority(bool ascending) {
+        defaultList().sortTasksByPriority(ascending);
+    }
+
+    void Task::sortTasksByDueDate(bool ascending) {
+        defaultList().sortTasksByDueDate(ascending);
+    }
+
+    void Task::filterTasksByStatus(bool completedStatus) {
+        defaultList().filterTasksByStatus(completedStatus);
+    }
+
+    void Task::filterTasksByPriority(Priority prio) {
+        defaultList().filterTasksByPriority(prio);
+    }
+
+    void Task::displayCompletionPercentage() {
+        defaultList().displayCompletionPercentage();
+    }
+
+    std::optional<TaskRow> Task::findTask(int id) {
+        return defaultList().findTask(id);
+    }
+
+    TaskStats Task::statistics() {
+        return defaultList().statistics();
+    }
+
+    void Task::displayStatistics() {
+        defaultList().displayStatistics();
+    }
+
+    std::vector<TaskRow> Task::runQuery(const TaskQuery& query) {
+        return defaultList().runQuery(query);
+    }
+
+    TaskCursor Task::openCursor(const TaskQuery& query, size_t pageSize) {
+        return defaultList().openCursor(query, pageSize);
+    }
+
+    std::vector<int> Task::searchTasks(std::string_view query) {
+        return defaultList().searchTasks(query);
+    }
+
+    void Task::displaySearchResults(std::string_view query) {
+        defaultList().displaySearchResults(query);
+    }
+
+    size_t Task::searchIndexBytes() {
+        return defaultList().searchIndexBytes();
+    }
+
+    DueCounts Task::countDue(int fromDay, int toDay) {
+        return defaultList().countDue(fromDay, toDay);
+    }
+
+    std::vector<TaskRow> Task::tasksDue(int fromDay, int toDay, std::optional<bool> completed) {
+        return defaultList().tasksDue(fromDay, toDay, completed);
+    }
+
+    void Task::displayDueSummary(int soonDays) {
+        defaultList().displayDueSummary(soonDays);
+    }
+
+    void Task::setConcurrentAccess(bool enabled) {
+        defaultList().setConcurrentAccess(enabled);
+    }
+
+    std::shared_ptr<const TaskSnapshot> Task::snapshot() {
+        return defaultList().snapshot();
+    }
+
+    void Task::writeBatch(const std::function<void()>& edits) {
+        defaultList().writeBatch(edits);
+    }
+
+    void Task::openJournal(const std::string& snapshotFile, JournalOptions options) {
+        defaultList().openJournal(snapshotFile, options);
+    }
+
+    void Task::syncJournal() {
+        defaultList().syncJournal();
+    }
+
+    void Task::compactJournal() {
+        defaultList().compactJournal();
+    }
+
+    void Task::closeJournal(bool removeFile) {
+        defaultList().closeJournal(removeFile);
+    }
+
+    void Task::loadJournaledTasks(const std::string& snapshotFile) {
+        defaultList().loadJournaledTasks(snapshotFile);
+    }
+
+    void Task::startAutosave(const std::string& filename, AutosaveOptions options) {
+        defaultList().startAutosave(filename, options);
+    }
+
+    void Task::flushAutosave() {
+        defaultList().flushAutosave();
+    }
+
+    void Task::stopAutosave() {
+        defaultList().stopAutosave();
+    }
+
+    void Task::startReminders(std::function<void(const TaskRow&)> onDue, ReminderOptions options) {
+        defaultList().startReminders(std::move(onDue), std::move(options));
+    }
+
+    size_t Task::pollReminders() {
+        return defaultList().pollReminders();
+    }
+
+    void Task::stopReminders() {
+        defaultList().stopReminders();
+    }
+
+    /*----------------------------- BATCH MODE ----------------------------*/
+
+    namespace
+    {
+        // Splits the next blank-separated word off the front of `line`.
+        std::string_view nextWord(std::string_view& line) {
+            size_t begin = line.find_first_not_of(" \t\r");
+            if (begin == std::string_view::npos) {
+                line = {};
+                return {};
+            }
+            size_t end = line.find_first_of(" \t\r", begin);
+            if (end == std::string_view::npos) end = line.size();
+            std::string_view word = line.substr(begin, end - begin);
+            line.remove_prefix(end);
+            return word;
+        }
+
+        // The rest of the line, minus surrounding blanks.
+        std::string_view restOfLine(std::string_view line) {
+            size_t begin = line.find_first_not_of(" \t");
+            if (begin == std::string_view::npos) return {};
+            size_t end = line.find_last_not_of(" \t\r");
+            return line.substr(begin, end - begin + 1);
+        }
+
+        template <typename Int>
+        bool parseNumber(std::string_view word, Int& value) {
+            auto result = std::from_chars(word.data(), word.data() + word.size(), value);
+            return !word.empty() && result.ec == std::errc() && result.ptr == word.data() + word.size();
+        }
+
+        bool parsePriority(std::string_view word, Priority& prio) {
+            int value = 0;
+            if (!parseNumber(word, value) || value < HIGHEST || value > LOWEST) return false;
+            prio = static_cast<Priority>(value);
+            return true;
+        }
+
+        // YYYY-MM-DD. Scripts reuse a limited set of dates and mktime is
+        // slow (it re-checks the time zone on every call), so conversions
+        // are kept in a small direct-mapped cache keyed by the date.
+        bool parseDate(std::string_view word, time_t& due) {
+            struct CachedDate {
+                int key = -1;
+                time_t due = 0;
+            };
+            static CachedDate cache[256];
+
+            int year = 0;
+            int month = 0;
+            int day = 0;
+            if (word.size() != 10 || word[4] != '-' || word[7] != '-') return false;
+            for (size_t i : { 0, 1, 2, 3, 5, 6, 8, 9 }) {
+                if (word[i] < '0' || word[i] > '9') return false;
+            }
+            parseNumber(word.substr(0, 4), year);
+            parseNumber(word.substr(5, 2), month);
+            parseNumber(word.substr(8, 2), day);
+            // Four, two and two plain digits, so the key is unique.
+            int key = (year * 100 + month) * 100 + day;
+            CachedDate& cached = cache[static_cast<size_t>(key) % 256];
+            if (cached.key != key) {
+                std::optional<time_t> parsed = makeDueDate(year, month, day);
+                if (!parsed) return false;
+                cached.key = key;
+                cached.due = *parsed;
+            }
+            due = cached.due;
+            return true;
+        }
+
+        // Applies one command line; returns false if it could not be parsed.
+        // updateTask and deleteTask only warn about a missing ID; a batch
+        // has to count it as rejected.
+        bool taskExists(int id) {
+            if (Task::findTask(id)) return true;
+            std::cerr << "Error: No task found with ID " << id << ".\n";
+            return false;
+        }
+
+        bool runBatchCommand(std::string_view line, const std::string& snapshotFile) {
+            std::string_view command = nextWord(line);
+            if (command.empty() || command[0] == '#') {
+                return true;
+            }
+            if (command == "add") {
+                Priority prio;
+                time_t due = 0;
+                if (!parsePriority(nextWord(line), prio) || !parseDate(nextWord(line), due)) return false;
+                std::string_view desc = restOfLine(line);
+                if (desc.empty()) return false;
+                return Task::addTask(std::string(desc), prio, due) != 0;
+            }
+            if (command == "update") {
+                int id = 0;
+                if (!parseNumber(nextWord(line), id) || !taskExists(id)) return false;
+                std::string_view field = nextWord(line);
+                if (field == "description") {
+                    std::string_view desc = restOfLine(line);
+                    if (desc.empty() || !fitsTextRecord(desc)) return false;
+                    Task::updateTask(id, std::string(desc));
+                    return true;
+                }
+                std::string_view value = nextWord(line);
+                if (field == "priority") {
+                    Priority prio;
+                    if (!parsePriority(value, prio)) return false;
+                    Task::updateTask(id, {}, prio);
+                }
+                else if (field == "completed") {
+                    if (value != "0" && value != "1") return false;
+                    Task::updateTask(id, {}, {}, value == "1");
+                }
+                else if (field == "due") {
+                    time_t due = 0;
+                    if (!parseDate(value, due)) return false;
+                    Task::updateTask(id, {}, {}, {}, due);
+                }
+                else {
+                    return false;
+                }
+                return true;
+            }
+            if (command == "delete" || command == "complete") {
+                int id = 0;
+                if (!parseNumber(nextWord(line), id) || !taskExists(id)) return false;
+                if (command == "delete") {
+                    Task::deleteTask(id);
+                }
+                else {
+                    Task::updateTask(id, {}, {}, true, {});
+                }
+                return true;
+            }
+            if (command == "sort") {
+                std::string_view key = nextWord(line);
+                std::string_view order = nextWord(line);
+                if (order != "" && order != "asc" && order != "desc") return false;
+                bool ascending = order != "desc";
+                if (key == "priority") {
+                    Task::sortTasksByPriority(ascending);
+                }
+                else if (key == "due") {
+                    Task::sortTasksByDueDate(ascending);
+                }
+                else {
+                    return false;
+                }
+                return true;
+            }
+            if (command == "filter") {
+                std::string_view status = nextWord(line);
+                if (status != "completed" && status != "pending") return false;
+                Task::filterTasksByStatus(status == "completed");
+                return true;
+            }
+            if (command == "search") {
+                std::string_view query = restOfLine(line);
+                if (query.empty()) return false;
+                Task::displaySearchResults(query);
+                return true;
+            }
+            if (command == "due") {
+                int days = 7;
+                std::string_view word = nextWord(line);
+                if (!word.empty() && (!parseNumber(word, days) || days < 0)) return false;
+                Task::displayDueSummary(days);
+                return true;
+            }
+            if (command == "stats") {
+                Task::displayStatistics();
+                return true;
+            }
+            if (command == "display") {
+                Task::displayTasks();
+                return true;
+            }
+            if (command == "save") {
+                Task::saveTasksToFile(snapshotFile);
+                return true;
+            }
+            return false;
+        }
+    }
+
+    size_t runBatch(std::istream& in, const std::string& snapshotFile) {
+        // Every command is still journaled, but nothing is fsynced or
+        // compacted until the journal is folded in at the end.
+        JournalOptions options;
+        options.syncEveryRecords = std::numeric_limits<size_t>::max();
+        options.compactThresholdBytes = std::numeric_limits<size_t>::max();
+        Task::openJournal(snapshotFile, options);
+
+        size_t failed = 0;
+        size_t lineNumber = 0;
+        std::string line;
+        while (std::getline(in, line)) {
+            ++lineNumber;
+            if (!runBatchCommand(line, snapshotFile)) {
+                std::cerr << "Line " << lineNumber << ": rejected: " << line << "\n";
+                ++failed;
+            }
+        }
+
+        // Saves, and leaves no .wal behind unless the save failed.
+        Task::closeJournal(true);
+        return failed;
+    }
+
+    /*----------------------------- SERVER MODE ---------------------------*/
+
+#ifdef __linux__
+    namespace
+    {
+        struct ServerClient {
+            std::string requests;    // received, not yet answered
+            std::string replies;     // answered, not yet sent
+            size_t sent = 0;         // bytes of `replies` already sent
+            uint32_t interest = 0;   // epoll events currently registered
+            bool inRound = false;    // already queued for this round
+            bool closed = false;     // sends no more; dropped once answered
+        };
+
+        constexpr size_t maxRequestBytes = 64 * 1024;
+
+        bool hasCompleteRequest(const ServerClient& client) {
+            return client.requests.find('\n') != std::string::npos;
+        }
+
+        bool repliesBacklogged(const ServerClient& client, const ServerOptions& options) {
+            return client.replies.size() - client.sent > options.maxPendingReplyBytes;
+        }
+
+        // Answers one request line into `reply`. Edits reuse the batch
+        // commands once the task they name is known to exist, so a bad ID
+        // is an error reply rather than a warning on the server's stderr.
+        void runServerRequest(std::string_view line, std::string& reply) {
+            std::string_view rest = line;
+            std::string_view command = nextWord(rest);
+
+            if (command == "add") {
+                Priority prio;
+                time_t due = 0;
+                if (!parsePriority(nextWord(rest), prio) || !parseDate(nextWord(rest), due)) {
+                    reply += "error invalid request\n";
+                    return;
+                }
+                // Checked here so a bad request is only reported to its client.
+                std::string_view desc = restOfLine(rest);
+                int id = desc.empty() || !fitsTextRecord(desc) ? 0 : Task::addTask(std::string(desc), prio, due);
+                if (id == 0) {
+                    reply += "error invalid request\n";
+                    return;
+                }
+                reply += "ok ";
+                reply += std::to_string(id);
+                reply += '\n';
+                return;
+            }
+            if (command == "update" || command == "delete" || command == "complete" || command == "get") {
+                int id = 0;
+                if (!parseNumber(nextWord(rest), id)) {
+                    reply += "error invalid request\n";
+                    return;
+                }
+                std::optional<TaskRow> task = Task::findTask(id);
+                if (!task) {
+                    reply += "error no task ";
+                    reply += std::to_string(id);
+                    reply += '\n';
+                    return;
+                }
+                if (command != "get") {
+                    reply += runBatchCommand(line, std::string()) ? "ok\n" : "error invalid request\n";
+                    return;
+                }
+                const LocalDayCache::Day* day = dueDays.find(task->dueDate);
+                reply += "ok ";
+                reply += std::to_string(task->id);
+                reply += ' ';
+                reply += std::to_string(static_cast<int>(task->priority));
+                reply += ' ';
+                reply += day ? day->text : "-";
+                reply += task->completed ? " 1 " : " 0 ";
+                reply += task->description;
+                reply += '\n';
+                return;
+            }
+            if (command == "count") {
+                TaskStats stats = Task::statistics();
+                reply += "ok " + std::to_string(stats.total) + " " + std::to_string(stats.completed)
+                    + " " + std::to_string(stats.overdue) + "\n";
+                return;
+            }
+            if (command == "due") {
+                int days = 7;
+                std::string_view word = nextWord(rest);
+                if (!word.empty() && (!parseNumber(word, days) || days < 0)) {
+                    reply += "error invalid request\n";
+                    return;
+                }
+                DueCounts counts = Task::countDue(0, days);
+                reply += "ok " + std::to_string(counts.pending) + " " + std::to_string(counts.completed) + "\n";
+                return;
+            }
+            if (command == "search") {
+                std::string_view query = restOfLine(rest);
+                if (query.empty()) {
+                    reply += "error invalid request\n";
+                    return;
+                }
+                std::vector<int> ids = Task::searchTasks(query);
+                reply += "ok ";
+                reply += std::to_string(ids.size());
+                for (int id : ids) {
+                    reply += ' ';
+                    reply += std::to_string(id);
+                }
+                reply += '\n';
+                return;
+            }
+            if (command == "save") {
+                // The journal already holds every edit; a full rewrite
+                // would stall every client for O(n).
+                Task::syncJournal();
+                reply += "ok\n";
+                return;
+            }
+            if (command == "ping") {
+                reply += "ok\n";
+                return;
+            }
+            reply += "error unknown command\n";
+        }
+
+        // Answers up to options.maxRequestsPerClient complete requests.
+        void answerClient(ServerClient& client, const ServerOptions& options) {
+            size_t start = 0;
+            for (size_t answered = 0; answered < options.maxRequestsPerClient; ++answered) {
+                size_t end = client.requests.find('\n', start);
+                if (end == std::string::npos) break;
+                runServerRequest(std::string_view(client.requests).substr(start, end - start), client.replies);
+                start = end + 1;
+            }
+            client.requests.erase(0, start);
+            if (client.requests.size() > maxRequestBytes && !hasCompleteRequest(client)) {
+                client.replies += "error request too long\n";
+                client.requests.clear();
+                client.closed = true;
+            }
+        }
+
+        void receiveRequests(int fd, ServerClient& client) {
+            char buffer[16 * 1024];
+            while (client.requests.size() <= maxRequestBytes) {
+                ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+                if (received > 0) {
+                    client.requests.append(buffer, static_cast<size_t>(received));
+                    continue;
+                }
+                if (received < 0 && errno == EINTR) continue;
+                if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    client.closed = true;
+                }
+                return;
+            }
+        }
+
+        void sendReplies(int fd, ServerClient& client) {
+            while (client.sent < client.replies.size()) {
+                ssize_t sent = send(fd, client.replies.data() + client.sent,
+                    client.replies.size() - client.sent, MSG_NOSIGNAL);
+                if (sent > 0) {
+                    client.sent += static_cast<size_t>(sent);
+                    continue;
+                }
+                if (sent < 0 && errno == EINTR) continue;
+                if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+                client.closed = true;
+                client.requests.clear();
+                client.replies.clear();
+                client.sent = 0;
+                return;
+            }
+            if (client.sent == client.replies.size()) {
+                client.replies.clear();
+                client.sent = 0;
+            }
+            else if (client.sent > client.replies.size() / 2) {
+                client.replies.erase(0, client.sent);
+                client.sent = 0;
+            }
+        }
+    }
+
+    int runServer(const std::string& socketPath, const std::string& snapshotFile, ServerOptions options) {
+        sockaddr_un address{};
+        if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+            std::cerr << "Error: Invalid socket path " << socketPath << ".\n";
+            return 1;
+        }
+        address.sun_family = AF_UNIX;
+        std::copy(socketPath.begin(), socketPath.end(), address.sun_path);
+        // A stale socket from an earlier run is replaced; anything else at
+        // the path (say, a tasks file given by mistake) is left alone.
+        struct stat existing;
+        if (lstat(socketPath.c_str(), &existing) == 0 && !S_ISSOCK(existing.st_mode)) {
+            std::cerr << "Error: " << socketPath << " exists and is not a socket.\n";
+            return 1;
+        }
+
+        // SIGINT and SIGTERM are read from the event loop. They are blocked
+        // before the journal starts any thread, so no thread takes them.
+        sigset_t stopSignals;
+        sigset_t previousMask;
+        sigemptyset(&stopSignals);
+        sigaddset(&stopSignals, SIGINT);
+        sigaddset(&stopSignals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &stopSignals, &previousMask);
+
+        // Batches are synced as a whole (or on "save"), never mid-batch.
+        JournalOptions journalOptions;
+        journalOptions.syncEveryRecords = std::numeric_limits<size_t>::max();
+        Task::openJournal(snapshotFile, journalOptions);
+
+        int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int signals = signalfd(-1, &stopSignals, SFD_NONBLOCK | SFD_CLOEXEC);
+        int events = epoll_create1(EPOLL_CLOEXEC);
+        bool listening = listener >= 0 && signals >= 0 && events >= 0;
+        struct stat bound {};
+        bool ownsSocket = false;
+        if (listening) {
+            if (lstat(socketPath.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode)) {
+                unlink(socketPath.c_str());
+            }
+            ownsSocket = bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0
+                && lstat(socketPath.c_str(), &bound) == 0;
+            listening = ownsSocket && listen(listener, SOMAXCONN) == 0;
+        }
+        if (listening) {
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = listener;
+            listening = epoll_ctl(events, EPOLL_CTL_ADD, listener, &event) == 0;
+            event.data.fd = signals;
+            listening = listening && epoll_ctl(events, EPOLL_CTL_ADD, signals, &event) == 0;
+        }
+        if (!listening) {
+            std::cerr << "Error: Unable to listen on " << socketPath << ": " << std::strerror(errno) << "\n";
+        }
+        else {
+            std::cout << "Serving " << Task::statistics().total << " tasks on " << socketPath << ".\n";
+        }
+
+        std::unordered_map<int, ServerClient> clients;
+        std::vector<int> round;     // clients with something to do this round
+        std::vector<int> carried;   // clients left with unanswered requests
+        std::vector<epoll_event> ready(256);
+        bool running = listening;
+        while (running) {
+            int count = epoll_wait(events, ready.data(), static_cast<int>(ready.size()), carried.empty() ? -1 : 0);
+            if (count < 0) {
+                if (errno == EINTR) continue;
+                std::cerr << "Error: epoll_wait failed: " << std::strerror(errno) << "\n";
+                break;
+            }
+
+            round.clear();
+            for (int fd : carried) {
+                clients[fd].inRound = true;
+                round.push_back(fd);
+            }
+            carried.clear();
+            for (int i = 0; i < count; ++i) {
+                int fd = ready[i].data.fd;
+                if (fd == signals) {
+                    // Consumed, or it would fire when the mask is restored.
+                    signalfd_siginfo info;
+                    while (read(signals, &info, sizeof(info)) == sizeof(info)) {}
+                    running = false;
+                    continue;
+                }
+                if (fd == listener) {
+                    int accepted;
+                    while ((accepted = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                        epoll_event event{};
+                        event.events = EPOLLIN;
+                        event.data.fd = accepted;
+                        if (epoll_ctl(events, EPOLL_CTL_ADD, accepted, &event) != 0) {
+                            close(accepted);
+                            continue;
+                        }
+                        clients[accepted].interest = EPOLLIN;
+                    }
+                    continue;
+                }
+                ServerClient& client = clients[fd];
+                if (ready[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                    receiveRequests(fd, client);
+                }
+                if (!client.inRound) {
+                    client.inRound = true;
+                    round.push_back(fd);
+                }
+            }
+
+            // Everything received this round is one batch: one hold of the
+            // writer lock, one journal sync, then the replies go out.
+            Task::writeBatch([&clients, &round, &options] {
+                for (int fd : round) {
+                    ServerClient& client = clients[fd];
+                    if (!repliesBacklogged(client, options)) {
+                        answerClient(client, options);
+                    }
+                }
+            });
+            if (options.syncBeforeReply) {
+                Task::syncJournal();
+            }
+
+            for (int fd : round) {
+                ServerClient& client = clients[fd];
+                client.inRound = false;
+                sendReplies(fd, client);
+                bool unsent = client.sent < client.replies.size();
+                // Requests sent before a hang-up are still answered.
+                if (client.closed && !unsent && !hasCompleteRequest(client)) {
+                    epoll_ctl(events, EPOLL_CTL_DEL, fd, nullptr);
+                    close(fd);
+                    clients.erase(fd);
+                    continue;
+                }
+                // A client with a reply backlog is not read until it drains.
+                bool backlogged = repliesBacklogged(client, options);
+                if (!backlogged && hasCompleteRequest(client)) {
+                    carried.push_back(fd);
+                }
+                uint32_t interest = (client.closed || backlogged ? 0u : uint32_t(EPOLLIN)) | (unsent ? uint32_t(EPOLLOUT) : 0u);
+                if (interest != client.interest) {
+                    epoll_event event{};
+                    event.events = interest;
+                    event.data.fd = fd;
+                    epoll_ctl(events, EPOLL_CTL_MOD, fd, &event);
+                    client.interest = interest;
+                }
+            }
+        }
+
+        for (const auto& entry : clients) {
+            close(entry.first);
+        }
+        if (events >= 0) close(events);
+        if (signals >= 0) close(signals);
+        if (listener >= 0) {
+            close(listener);
+        }
+        // Only the socket this process bound is removed, not whatever was
+        // put at the path since.
+        struct stat current;
+        if (ownsSocket && lstat(socketPath.c_str(), &current) == 0
+            && current.st_dev == bound.st_dev && current.st_ino == bound.st_ino) {
+            unlink(socketPath.c_str());
+        }
+        if (listening) {
+            Task::saveTasksToFile(snapshotFile);
+        }
+        Task::closeJournal();
+        pthread_sigmask(SIG_SETMASK, &previousMask, nullptr);
+        return listening ? 0 : 1;
+    }
+#else
+    int runServer(const std::string& socketPath, const std::string&, ServerOptions) {
+        std::cerr << "Error: Server mode (" << socketPath << ") needs Linux.\n";
+        return 1;
+    }
+#endif
+
 } // end namespace MyLibrary
@@ -6,15 +6,32 @@
 #include <fstream>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <memory>
 #include <algorithm>
 #include <ctime>
 #include <iomanip>
 #include <optional>
 #include <limits>
+#include <unordered_map>
+#include <set>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <cstdint>
+#include <functional>
 
 // For MSVC localtime_s usage (optional)
 #include <cstring>  
 
+// Operation timers, I/O byte counts and heap allocation counts (see
+// instrumentationStats). Off unless defined as 1 for the whole build:
+// counting allocations replaces the global operator new and delete of
+// every program that links the library.
+#ifndef MYLIBRARY_INSTRUMENTATION
+#define MYLIBRARY_INSTRUMENTATION 0
+#endif
+
 namespace MyLibrary
 {
     enum Priority {
@@ -46,28 +63,786 @@ namespace MyLibrary
      */
     time_t promptForDueDate();
 
-    class Task {
-    private:
+    /**
+     * Noon local time on the given date, or std::nullopt if mktime rejects it.
+     */
+    std::optional<time_t> makeDueDate(int year, int month, int day);
+
+    /**
+     * Tuning for the write-ahead journal (see TaskList::openJournal).
+     */
+    struct JournalOptions {
+        // Records appended between fsync calls; 1 syncs every mutation.
+        size_t syncEveryRecords = 64;
+        // Journal size in bytes that triggers a background compaction
+        // into a fresh snapshot.
+        size_t compactThresholdBytes = 4 * 1024 * 1024;
+    };
+
+    /**
+     * Tuning for loadTasksFromFile's parallel text parser. Records are
+     * merged in file order, so the result (IDs, skipped-record warnings)
+     * is the same for any worker count.
+     */
+    struct LoadOptions {
+        // Parser chunks, parsed on the shared worker pool; 0 uses one per
+        // hardware thread.
+        unsigned workers = 0;
+        // Files are split so no worker gets less than this; smaller files
+        // are parsed on the calling thread alone.
+        size_t minBytesPerWorker = 4 * 1024 * 1024;
+    };
+
+    /**
+     * Multi-threading of sorts and filters on large task lists. The work
+     * runs on one worker pool shared with the text loader; lists below
+     * minParallelTasks take the serial path. Results don't depend on the
+     * thread count.
+     */
+    struct ParallelOptions {
+        // Threads per operation, the caller included; 0 uses one per
+        // hardware thread.
+        unsigned threads = 0;
+        size_t minParallelTasks = 64 * 1024;
+    };
+
+    void setParallelOptions(ParallelOptions options);
+
+    /**
+     * One task as returned by TaskList::runQuery. The description points into
+     * the task store and stays valid until the next add, update, delete,
+     * load or compaction.
+     */
+    struct TaskRow {
         int id;
-        std::string description;
+        std::string_view description;
         Priority priority;
         bool completed;
         time_t dueDate;
+    };
+
+    /**
+     * Pending and completed tasks due within a range of days, as counted
+     * by TaskList::countDue.
+     */
+    struct DueCounts {
+        size_t pending = 0;
+        size_t completed = 0;
+    };
+
+    /**
+     * Task counts from TaskList::statistics. The per-priority arrays are indexed
+     * by Priority; [0] counts any value outside HIGHEST..LOWEST.
+     */
+    struct TaskStats {
+        size_t total = 0;
+        size_t completed = 0;
+        size_t overdue = 0;  // pending and due before today
+        size_t byPriority[6] = {};
+        size_t completedByPriority[6] = {};
+    };
+
+    /**
+     * Conditions, order and limit for TaskList::runQuery. Unset conditions
+     * match every task; all set ones must hold.
+     */
+    struct TaskQuery {
+        enum class Order { Insertion, Priority, DueDate };
+
+        std::optional<bool> completed;
+        std::optional<Priority> priorityAtLeast;  // numerically: HIGHEST is 1
+        std::optional<Priority> priorityAtMost;
+        std::optional<time_t> dueFrom;            // inclusive
+        std::optional<time_t> dueBefore;          // exclusive
+        std::string descriptionContains;          // empty: any
+
+        Order orderBy = Order::Insertion;         // ties are broken by ID
+        bool ascending = true;
+        size_t limit = 0;                         // 0: no limit
+    };
+
+    /**
+     * On-disk formats understood by loadTasksFromFile / saveTasksToFile.
+     * Text is the pipe-delimited tasks.txt format (ending in a "#nextId"
+     * line); Binary is a versioned snapshot (header, fixed-width records,
+     * one description blob).
+     */
+    enum class FileFormat {
+        Auto,    // by file extension (".bin" = Binary), loads also sniff the header
+        Text,
+        Binary
+    };
+
+    /**
+     * Tuning for the background autosave (see TaskList::startAutosave).
+     */
+    struct AutosaveOptions {
+        // How long the worker waits after a change before writing, so a
+        // burst of edits becomes one write.
+        unsigned delayMs = 500;
+        FileFormat format = FileFormat::Auto;
+    };
+
+    /**
+     * Tuning for due-date reminders (see TaskList::startReminders).
+     */
+    struct ReminderOptions {
+        // How long before the due date a reminder fires.
+        time_t leadSeconds = 0;
+        // The current time; std::time when empty. Tests and simulations
+        // pass their own to step through days without waiting.
+        std::function<time_t()> clock;
+    };
+
+    /**
+     * Pick a format from the file name: ".bin" is Binary, anything else Text.
+     */
+    FileFormat formatForFile(const std::string& filename);
+
+    /**
+     * Non-interactive mode: applies one command per line from `in` to the
+     * tasks in `snapshotFile` (through its journal) and saves once at the end.
+     *
+     *   add <priority> <YYYY-MM-DD> <description>
+     *   update <id> description <text> | priority <1-5> | completed <0|1> | due <YYYY-MM-DD>
+     *   delete <id>
+     *   complete <id>
+     *   sort priority|due [asc|desc]
+     *   filter completed|pending
+     *   search <words>   (see TaskList::searchTasks)
+     *   due [days]       (see TaskList::displayDueSummary)
+     *   stats
+     *   display
+     *   save
+     *
+     * Blank lines and lines starting with '#' are skipped. The journal is
+     * folded into `snapshotFile` and removed at the end. Returns the number
+     * of lines rejected: ones that could not be parsed or that name a
+     * missing task.
+     */
+    size_t runBatch(std::istream& in, const std::string& snapshotFile);
+
+    /**
+     * Tuning for runServer.
+     */
+    struct ServerOptions {
+        // Requests read from one client per wakeup; the rest wait for the
+        // next round so one busy client cannot starve the others.
+        size_t maxRequestsPerClient = 256;
+        // Replies pending for a client before the server stops reading
+        // its requests until it catches up.
+        size_t maxPendingReplyBytes = 1024 * 1024;
+        // Whether every batch of mutations is fsynced before it is
+        // acknowledged. Without it the journal syncs only on "save" and
+        // at shutdown.
+        bool syncBeforeReply = true;
+    };
+
+    /**
+     * Server mode (Linux only): keeps the tasks in `snapshotFile` loaded and
+     * journaled, and answers clients on the Unix domain socket `socketPath`
+     * until SIGINT or SIGTERM, then saves.
+     *
+     * Each request is one line and gets exactly one reply line, in order,
+     * so clients may pipeline. Every request that arrives in one wakeup of
+     * the event loop runs under one hold of the writer lock, and the
+     * journal is synced once for all of them (see ServerOptions).
+     *
+     *   add <priority> <YYYY-MM-DD> <description>       -> ok <id>
+     *   update, delete, complete                        -> ok   (as in runBatch)
+     *   get <id>        -> ok <id> <priority> <YYYY-MM-DD> <0|1> <description>
+     *   count           -> ok <total> <completed> <overdue>
+     *   due [days]      -> ok <pending> <completed>   (due from today on, within days)
+     *   search <words>  -> ok <n> <id>...
+     *   save            -> ok   (syncs the journal)
+     *   ping            -> ok
+     *
+     * Anything else, a request naming a missing task, or a description
+     * holding '|' (which tasks.txt could not store) gets "error <reason>"
+     * and changes nothing. A stale socket at `socketPath` is replaced, but
+     * any other file there is refused. Returns 0 after a clean shutdown, 1
+     * if the socket could not be set up.
+     */
+    int runServer(const std::string& socketPath, const std::string& snapshotFile,
+        ServerOptions options = {});
+
+    /**
+     * Operations timed by the instrumentation. A call counts once however
+     * it is made (Task or TaskList); calls an operation makes internally
+     * (openJournal's load and replayed edits, for one) belong to it.
+     * openJournal counts as a Load.
+     */
+    enum class Operation {
+        Load, Save, Add, Update, Delete,
+        SortByPriority, SortByDueDate, FilterByStatus, FilterByPriority, Display,
+        Count
+    };
+
+    constexpr size_t latencyBucketCount = 40;  // bucket b holds [2^b, 2^(b+1)) ns
+
+    /**
+     * Totals for one Operation since start-up or resetInstrumentation.
+     * Percentiles are the upper bounds of histogram buckets, so within 2x
+     * of the exact value. Allocations and bytes are those of the calling
+     * thread during the call; work handed to the worker pool is not in them.
+     */
+    struct OperationStats {
+        uint64_t calls = 0;
+        uint64_t totalNs = 0;
+        uint64_t maxNs = 0;
+        uint64_t p50Ns = 0;
+        uint64_t p90Ns = 0;
+        uint64_t p99Ns = 0;
+        uint64_t allocations = 0;
+        uint64_t bytesRead = 0;
+        uint64_t bytesWritten = 0;
+        uint64_t histogram[latencyBucketCount] = {};
+    };
+
+    struct InstrumentationStats {
+        bool enabled = false;  // false when compiled out; everything else is 0 then
+        OperationStats operations[static_cast<size_t>(Operation::Count)];
+        // Process-wide, all threads. The heap counts cover the whole
+        // program and are not reset.
+        uint64_t heapAllocations = 0;
+        uint64_t heapBytesInUse = 0;
+        uint64_t bytesRead = 0;
+        uint64_t bytesWritten = 0;
+    };
+
+    const char* operationName(Operation op);
+    InstrumentationStats instrumentationStats();
+    void resetInstrumentation();
+    void displayInstrumentation();  // per-operation table on std::cout
+    bool saveInstrumentationJson(const std::string& filename);
+
+    class TaskList;
+
+    /**
+     * Pages through the tasks of a TaskList that match a TaskQuery, in the
+     * query's order, from TaskList::openCursor (query.limit is ignored).
+     * Nothing is copied or sorted up front. Each call walks the live list
+     * (insertion order) or its sorted indexes from the current page's
+     * first or last row, so a page costs O(log n + tasks visited) however
+     * long the list is. The one exception is the first sorted page after a
+     * load, which builds the sorted indexes as a sort call would. Edits
+     * between calls show up in the next page. Rows are valid as TaskRow
+     * says.
+     */
+    class TaskCursor {
+    public:
+        std::vector<TaskRow> next();      // the first page, then each one after it
+        std::vector<TaskRow> previous();  // the page before; empty on the first page
+        std::vector<TaskRow> current();   // the current page again, as it is now
+        // The page starting at task `id`; empty (and the cursor stays
+        // put) if the task is not in the view.
+        std::vector<TaskRow> seek(int id);
+        bool hasNext();
+        bool hasPrevious();
+        size_t pageSize() const { return rowsPerPage; }
+
+    private:
+        friend class TaskList;
+        // Where a row sits in the view: its slot (insertion order) or its
+        // sort key, plus its ID.
+        struct Position {
+            int64_t key = 0;
+            int id = 0;
+        };
+        enum class Move { Next, Previous, Current, Seek };
 
-        static int nextId;
-        static std::vector<Task> tasks;
+        TaskCursor(TaskList& owner, const TaskQuery& view, size_t rows)
+            : list(&owner), query(view), rowsPerPage(rows) {}
 
-        // Validate description & priority
-        static bool validateTask(const std::string& desc, Priority prio);
+        TaskList* list;
+        TaskQuery query;
+        size_t rowsPerPage;
+        bool started = false;
+        Position first;  // first and last row of the current page
+        Position last;
+        uint64_t slotEpoch = 0;  // slot keys are only valid within one epoch
+    };
+
+    // The displayTasks table for a page of rows.
+    void displayRows(const std::vector<TaskRow>& rows);
 
+    /**
+     * Immutable view of all tasks at one point in time, from TaskList::snapshot.
+     * Any thread may hold and walk one while writers carry on: tasks are
+     * shared between versions in chunks of chunkSlots slots, and publishing
+     * a new version copies only the chunks that changed.
+     */
+    class TaskSnapshot {
+    public:
+        static constexpr size_t chunkSlots = 1024;
+
+        size_t size() const { return liveCount; }
+        uint64_t version() const { return snapshotVersion; }  // grows with every publish
+
+        // visit(const TaskRow&) for every task, in insertion order. The
+        // descriptions stay valid as long as the snapshot does.
+        template <typename Visitor>
+        void forEach(Visitor&& visit) const;
+        std::vector<TaskRow> filterByStatus(bool completedStatus) const;
+        void display(std::ostream& out) const;  // the TaskList::displayTasks table
+
+    private:
+        friend class TaskList;
+        struct Chunk {
+            std::vector<int32_t> ids;
+            std::vector<uint8_t> priorities;
+            std::vector<time_t> dueDates;
+            std::vector<std::string_view> descriptions;
+            uint64_t completedBits[chunkSlots / 64] = {};
+            uint64_t liveBits[chunkSlots / 64] = {};
+        };
+
+        std::vector<std::shared_ptr<const Chunk>> chunks;
+        std::vector<std::shared_ptr<char[]>> textBlocks;  // keeps the descriptions alive
+        size_t slots = 0;
+        size_t liveCount = 0;
+        uint64_t snapshotVersion = 0;
+    };
+
+    template <typename Visitor>
+    void TaskSnapshot::forEach(Visitor&& visit) const {
+        for (const auto& chunk : chunks) {
+            for (size_t i = 0; i < chunk->ids.size(); ++i) {
+                if (!((chunk->liveBits[i / 64] >> (i % 64)) & 1)) continue;
+                visit(TaskRow{ chunk->ids[i], chunk->descriptions[i],
+                    static_cast<Priority>(chunk->priorities[i]),
+                    ((chunk->completedBits[i / 64] >> (i % 64)) & 1) != 0, chunk->dueDates[i] });
+            }
+        }
+    }
+
+    /**
+     * One task list: its own storage, ID counter, indexes, journal and
+     * writer lock, so a process can host any number of independent lists.
+     * An empty list is about a kilobyte including one small allocation; the
+     * rest grows with its tasks. Task's static functions act on
+     * Task::defaultList().
+     */
+    class TaskList {
     public:
-        // Constructor
-        Task(const std::string& desc, Priority prio, time_t due);
+        TaskList();
+        ~TaskList();
+        TaskList(const TaskList&) = delete;
+        TaskList& operator=(const TaskList&) = delete;
+
+        // ---------- Tasks ----------
+        // Memory-maps the file and parses it in place (text files on several
+        // threads, see LoadOptions); records are validated exactly like the
+        // original stream-based reader.
+        void loadTasksFromFile(const std::string& filename,
+            FileFormat format = FileFormat::Auto, LoadOptions options = {});
+        void saveTasksToFile(const std::string& filename,
+            FileFormat format = FileFormat::Auto);
+        // Returns the new task's ID, or 0 if the description or priority is invalid.
+        int addTask(const std::string& desc, Priority prio, time_t due);
+        void deleteTask(int id);
+        void updateTask(int id,
+            std::optional<std::string> desc = {},
+            std::optional<Priority> prio = {},
+            std::optional<bool> comp = {},
+            std::optional<time_t> due = {});
+        void displayTasks();
+        void sortTasksByPriority(bool ascending = true);
+        void sortTasksByDueDate(bool ascending = true);
+        void filterTasksByStatus(bool completedStatus);
+        void filterTasksByPriority(Priority prio);
+        void displayCompletionPercentage();
+        // O(1) lookup by ID; the row is valid as long as a TaskRow is.
+        std::optional<TaskRow> findTask(int id);
+
+        // Counts kept up to date by every change, so polling is O(1) (the
+        // first call after a load builds the due-date buckets for `overdue`).
+        // Builds with MYLIBRARY_VERIFY_STATS defined also check them
+        // against a full scan on every call.
+        TaskStats statistics();
+        void displayStatistics();
+
+        // Matching tasks in the requested order, at most query.limit of
+        // them. With a limit only the top entries are ever sorted, and a
+        // sorted query whose index is already built (after a sort call)
+        // stops walking it at the limit.
+        std::vector<TaskRow> runQuery(const TaskQuery& query);
+        // Rows of the same query a page at a time; see TaskCursor.
+        TaskCursor openCursor(const TaskQuery& query = {}, size_t pageSize = 20);
+
+        // ---------- Full-text search ----------
+        // IDs (ascending) of the tasks whose descriptions match `query`.
+        // Words are case-insensitive and ANDed, "OR" separates alternatives
+        // and a trailing '*' matches any word with that prefix, e.g.
+        // "buy milk OR groc*".
+        std::vector<int> searchTasks(std::string_view query);
+        void displaySearchResults(std::string_view query);
+        size_t searchIndexBytes();  // posting lists, 0 until the first search
+
+        // ---------- Due dates ----------
+        // Days are local calendar days relative to today (0 is today, -1
+        // yesterday) and ranges are [fromDay, toDay); INT_MIN or INT_MAX
+        // leaves an end open. countDue only reads the per-day counters;
+        // tasksDue walks the due-date index, O(log n + k), earliest first.
+        DueCounts countDue(int fromDay, int toDay);
+        std::vector<TaskRow> tasksDue(int fromDay, int toDay,
+            std::optional<bool> completed = {});
+        // Overdue and due-soon counts, then the pending tasks due before
+        // the end of that window.
+        void displayDueSummary(int soonDays = 7);
+
+        // ---------- Concurrent access ----------
+        // With concurrent access on, any thread may call any of the functions
+        // here: writers are serialized by one lock and each change (or
+        // writeBatch) publishes a snapshot. Readers that want no lock at all
+        // use snapshot(). Switch it on or off while no other thread uses the list.
+        void setConcurrentAccess(bool enabled);
+        // The current version: lock-free with concurrent access on, brought
+        // up to date on demand otherwise.
+        std::shared_ptr<const TaskSnapshot> snapshot();
+        // Runs `edits` (calls to addTask, updateTask, ...) under one hold of
+        // the writer lock and publishes a single snapshot afterwards.
+        void writeBatch(const std::function<void()>& edits);
+
+        // ---------- Write-ahead journal ----------
+        // Loads `snapshotFile`, replays `<snapshotFile>.wal` on top of it and
+        // from then on appends every add/update/delete to the journal, so a
+        // save costs O(changes) instead of a full rewrite.
+        void openJournal(const std::string& snapshotFile, JournalOptions options = {});
+        void syncJournal();     // flush and fsync pending records
+        void compactJournal();  // fold the journal into a new snapshot now
+        // Folds the journal into the snapshot, then closes it; with
+        // removeFile, also deletes the journal once nothing is left in it.
+        void closeJournal(bool removeFile = false);
+        // The tasks openJournal would load, without opening the journal or
+        // changing either file.
+        void loadJournaledTasks(const std::string& snapshotFile);
+
+        // ---------- Autosave ----------
+        // Writes the list to `filename` on a worker thread after changes,
+        // at most once per options.delayMs. The worker copies only the
+        // snapshot chunks touched since its last write, writes a temp file
+        // and renames it over `filename`, so callers never wait for the
+        // disk and a crash leaves the old or the new file, never a partial
+        // one. Not for a file that is journaled or still has a journal
+        // (openJournal then closeJournal(true) folds one in). Neither
+        // flush nor stop may be called from inside writeBatch.
+        void startAutosave(const std::string& filename, AutosaveOptions options = {});
+        void flushAutosave();  // wait until every change so far is written
+        void stopAutosave();   // flush, then end the worker
+        size_t autosaveWrites();  // files written since startAutosave
+
+        // ---------- Reminders ----------
+        // Calls onDue once for each pending task when the clock passes its
+        // due date (less options.leadSeconds). Calls happen inside
+        // pollReminders, on the calling thread, earliest first. A task added,
+        // re-dated or reopened with a reminder time already past fires on
+        // the next poll. Tasks already past it when reminders start, or
+        // after a load, do not (displayDueSummary lists those). Adding,
+        // completing, re-dating and deleting tasks set or cancel reminders
+        // in O(1) on a hierarchical timing wheel. A poll costs O(levels +
+        // reminders fired), however many are scheduled and however far the
+        // clock moved. onDue may edit the list.
+        void startReminders(std::function<void(const TaskRow&)> onDue, ReminderOptions options = {});
+        size_t pollReminders();       // fires everything due by the clock; returns how many
+        void stopReminders();
+        size_t scheduledReminders();  // reminders not yet fired
+
+    private:
+        friend class Task;
+        friend class TaskCursor;
+
+        // Block-allocated storage for task descriptions: identical strings are
+        // stored once and everything is freed at once by clear(), so loading
+        // costs a few block allocations rather than one per task.
+        class StringArena {
+        public:
+            StringArena() = default;
+            StringArena(const StringArena& other);
+            StringArena& operator=(const StringArena& other);
+            StringArena(StringArena&&) = default;
+            StringArena& operator=(StringArena&&) = default;
+
+            // Returns a view of the pooled copy; valid until clear().
+            std::string_view intern(std::string_view text);
+            void clear();
+            const std::vector<std::shared_ptr<char[]>>& sharedBlocks() const { return blocks; }
+            size_t bytesStored() const { return storedBytes; }  // copied in since clear()
+
+        private:
+            // Blocks and the intern table start small and grow with the
+            // strings stored, up to these sizes, so an empty or short list
+            // stays cheap.
+            static constexpr size_t arenaBlockSize = 64 * 1024;
+            static constexpr size_t firstBlockSize = 256;
+            static constexpr size_t internTableSize = 1 << 16;  // powers of two
+            static constexpr size_t firstTableSize = 64;
+            std::string_view copyIn(std::string_view text);
+            void growTable();
+
+            // Shared so a copy (the compaction snapshot) keeps them alive.
+            std::vector<std::shared_ptr<char[]>> blocks;
+            size_t blockUsed = 0;
+            size_t blockSize = 0;
+            // Direct-mapped intern cache; a null `data` marks an empty entry.
+            struct InternEntry {
+                const char* data;
+                uint32_t length;
+                uint32_t hash;
+            };
+            std::vector<InternEntry> table;
+            size_t storedCount = 0;  // strings copied in since the table was emptied
+            size_t storedBytes = 0;
+        };
+
+        // Column-oriented storage for all tasks: one packed array per field,
+        // completion and liveness as bitsets (bit slot % 64 of word slot / 64)
+        // and descriptions as views into an arena, so a scan only pulls the
+        // column it reads through the cache. deleteTask clears a slot's live
+        // bit; the slot itself stays until compact().
+        struct TaskStore {
+            std::vector<int32_t> ids;
+            std::vector<uint8_t> priorities;
+            std::vector<time_t> dueDates;
+            std::vector<uint64_t> completedBits;
+            std::vector<uint64_t> liveBits;
+            std::vector<std::string_view> descriptions;  // into `text`
+            StringArena text;
+            // Live and completed slots per priority (indexed like TaskStats),
+            // kept by push, setPriority, setCompleted and markRemoved.
+            size_t liveByPriority[6] = {};
+            size_t completedByPriority[6] = {};
+            // Total length of the live descriptions, kept by push, markRemoved
+            // and updateTask; set against text.bytesStored() it tells how
+            // much of the arena is text no task points at any more.
+            size_t descriptionBytes = 0;
+
+            size_t size() const { return ids.size(); }
+            bool isLive(size_t slot) const;
+            bool isCompleted(size_t slot) const;
+            void setCompleted(size_t slot, bool value);
+            void setCompletedBit(size_t slot, bool value);  // leaves the counts alone
+            void setPriority(size_t slot, Priority prio);
+            void markRemoved(size_t slot);
+            size_t countLive() const;       // from the counts: O(1)
+            size_t countCompleted() const;
+            void push(int id, std::string_view desc, Priority prio, bool comp, time_t due);
+            // Like push, for a description already held by `text`'s blocks.
+            void pushShared(int id, std::string_view desc, Priority prio, bool comp, time_t due);
+            void reserve(size_t count);
+            void clear();
+            void compact();                 // drop removed slots, keeping order
+            TaskStore liveCopy() const;     // compacted copy sharing the arena
+        };
+
+        // Inverted index from description words to task IDs. Each word's
+        // posting list is a run of blocks of up to maxBlockIds ascending IDs,
+        // stored as varint deltas after the block's first ID, so a change
+        // re-encodes one small block and a lookup skips whole blocks.
+        class TextIndex {
+        public:
+            void add(int id, std::string_view text);
+            void remove(int id, std::string_view text);
+            void clear();
+            std::vector<int> search(std::string_view query) const;  // see searchTasks
+            size_t postingBytes() const;
+
+        private:
+            static constexpr uint32_t maxBlockIds = 128;
+            struct Block {
+                int32_t firstId = 0;
+                int32_t lastId = 0;
+                uint32_t count = 0;
+                std::vector<uint8_t> deltas;  // count - 1 varints
+            };
+            struct PostingList {
+                std::vector<Block> blocks;
+                size_t size = 0;
+            };
+
+            static void decode(const Block& block, std::vector<int>& ids);
+            static void encode(Block& block, const int* first, const int* last);
+            static size_t findBlock(const PostingList& list, int id);
+            void insertId(PostingList& list, int id);
+            void eraseId(PostingList& list, int id);
+            static std::vector<int> idsOf(const PostingList& list);
+            static void intersect(std::vector<int>& ids, const PostingList& list);
+
+            std::unordered_map<std::string_view, PostingList> terms;  // keys in termText
+            std::set<std::string_view> sortedTerms;  // the same keys, for prefix searches
+            StringArena termText;
+            // Scratch buffers reused by add and remove.
+            std::string lowered;
+            std::vector<std::string_view> words;
+            std::vector<int> ids;
+        };
+
+        struct JournalState;  // write-ahead journal files and compaction worker
+        struct AutosaveState;  // autosave worker and its hand-off flags
+        struct ReminderState;  // timing wheel of pending tasks' reminders
+
+        int nextId = 1;
+        TaskStore store;
+
+        // ID -> slot in `store`, kept in sync by every operation that
+        // adds, removes or reorders tasks.
+        std::unordered_map<int, size_t> idIndex;
+        size_t removedCount = 0;
+        // Replaced descriptions stay in the arena until a compaction;
+        // updateTask compacts once they outweigh the live text by this much.
+        static constexpr size_t deadTextSlackBytes = 1024 * 1024;
+
+        // Secondary indexes ordered by (key, id). The sort functions only pick
+        // which one display/filter walk; `store` keeps its insertion order.
+        // Completion status needs no index: it is the completedBits column.
+        // Built on the first sort after a load, then kept up to date.
+        std::set<std::pair<int, int>> priorityIndex;
+        std::set<std::pair<time_t, int>> dueDateIndex;
+        bool sortedIndexesBuilt = false;
+
+        // Built on the first search after a load, then kept up to date.
+        TextIndex textIndex;
+        bool textIndexBuilt = false;
+
+        // Pending/completed counts per local calendar day of the due date
+        // (days since 1970-01-01); days without tasks have no entry. Built on
+        // the first due-date summary after a load, then kept up to date.
+        std::map<int64_t, DueCounts> dueBuckets;
+        bool dueBucketsBuilt = false;
+        // Pending tasks due before day `overdueDay`, adjusted with the
+        // buckets, so the overdue count is only re-summed when the date changes.
+        int64_t overdueDay = std::numeric_limits<int64_t>::min();
+        size_t overduePending = 0;
+
+        enum class SortOrder { Insertion, Priority, DueDate };
+        SortOrder sortOrder = SortOrder::Insertion;
+        bool sortAscending = true;
+
+        std::unique_ptr<JournalState> journal;
+        std::unique_ptr<AutosaveState> autosave;  // null unless started
+        std::unique_ptr<ReminderState> reminders;  // null unless started
+
+        // Concurrent access (see setConcurrentAccess). Every public
+        // operation holds a StoreLock: while concurrent access or autosave
+        // is on that is the list's recursive writer lock, and when the
+        // outermost holder releases it after a change, a new snapshot is
+        // published (concurrent access) or the autosave worker woken.
+        class StoreLock {
+        public:
+            explicit StoreLock(TaskList& list);
+            ~StoreLock();
+            StoreLock(const StoreLock&) = delete;
+            StoreLock& operator=(const StoreLock&) = delete;
+
+        private:
+            TaskList* locked;  // null while concurrent access is off
+        };
+
+        bool concurrentAccess = false;
+        std::recursive_mutex storeMutex;
+        int storeLockDepth = 0;  // guarded by storeMutex
+        std::shared_ptr<const TaskSnapshot> publishedSnapshot;  // atomic_load/store only
+        // Snapshot chunks written since the last publish; slots past the
+        // published ones are new and copied regardless.
+        std::vector<uint64_t> dirtyChunks;
+        bool allChunksDirty = false;
+        uint64_t slotEpoch = 0;  // counts touchAllSlots calls, for cursors' slot keys
+        // Live slots just before the last compaction, if nothing else has
+        // moved slots since: compaction keeps the order of live slots, so
+        // an old slot's new place is the number of live slots before it.
+        std::vector<uint64_t> compactedLiveBits;
+        void touchSlot(size_t slot);
+        void touchAllSlots();
+        bool snapshotStale();
+        void publishSnapshot();
+
+        // Validate description & priority; newText also requires one line
+        static bool validateTask(std::string_view desc, Priority prio, bool newText = true);
+
+        // Index helpers
+        void rebuildIndex();
+        void compactTasks();
+        void indexTask(size_t slot);
+        void unindexTask(size_t slot);
+        void rebuildSortedIndexes();
+        void dropSortedIndexes();
+        void buildTextIndex();
+        void dropTextIndex();
+        void buildDueBuckets();
+        void dropDueBuckets();
+        void countInDueBucket(time_t due, bool completed, bool add);
+        size_t countOverdue();
+        bool verifyStatistics(const TaskStats& stats);
+        template <typename Visitor>
+        void forEachInOrder(Visitor&& visit);
+        template <typename Table>
+        void writeTaskRow(Table& table, size_t slot);
+
+        // Format-specific readers/writers behind load/saveTasksToFile
+        void parseTextRecords(const char* pos, const char* end, const LoadOptions& options);
+        void parseBinarySnapshot(const char* pos, const char* end);
+        void insertLoadedTask(int id, std::string_view desc, Priority prio, bool comp, time_t due);
+        static bool writeTasksFile(const std::string& filename, FileFormat format,
+            const TaskStore& list, int listNextId);
+        static void writeTextRecords(std::ostream& file, const TaskStore& list, int listNextId);
+        static void writeBinarySnapshot(std::ostream& file, const TaskStore& list, int listNextId);
+        static bool replaceTasksFile(const std::string& filename, FileFormat format,
+            const TaskStore& list, int listNextId);
+
+        // Write-ahead journal internals
+        bool journalActive() const;
+        bool journalCoversSnapshot(const std::string& filename);
+        void appendJournalRecord(const std::string& record);
+        bool replayJournal(const char* pos, const char* end, uint64_t fingerprint,
+            size_t& baseOffset, size_t& validLength);
+        void applyJournalBase(const char* payload, const char* end);
+        static std::string journalBaseRecord(uint64_t fingerprint, int baseNextId);
+        static uint64_t contentFingerprint(const TaskStore& list, FileFormat format);
+        bool replaceJournal(const std::string& body);
+        bool reopenJournalForAppend();
+        void beginCompaction();
+        void finishCompaction(bool wait);
+
+        // Autosave internals
+        void scheduleAutosave();
+        void runAutosave();
+
+        // Reminder internals
+        void scheduleReminder(size_t slot);
+        void cancelReminder(int id);
+        void rescheduleReminders();
+
+        // Query evaluation
+        bool matchesQuery(const TaskQuery& query, size_t slot);
+
+        // Cursor paging
+        std::vector<TaskRow> cursorPage(TaskCursor& cursor, TaskCursor::Move move, int id = 0);
+        bool cursorHasMore(TaskCursor& cursor, bool forward);
+        bool cursorMatches(const TaskCursor& cursor, size_t slot);
+        TaskCursor::Position cursorPosition(const TaskCursor& cursor, size_t slot);
+        void walkCursor(const TaskCursor& cursor, const TaskCursor::Position* from, bool inclusive,
+            bool forward, size_t count, std::vector<size_t>& slots);
+    };
+
+    // Before TaskList, each Task object held one task and was made with
+    // Task(desc, prio, due). That constructor is gone: tasks live only in a
+    // list now, so add them with addTask (which returns the new ID) and read
+    // them back with findTask.
+    class Task {
+    public:
+        Task() = delete;  // static functions only
+
+        // The list every static function below works on.
+        static TaskList& defaultList();
 
         // ---------- Static Methods ----------
-        static void loadTasksFromFile(const std::string& filename);
-        static void saveTasksToFile(const std::string& filename);
-        static void addTask(const std::string& desc, Priority prio, time_t due);
+        // Each forwards to the TaskList member of the same name (see there)
+        // on defaultList().
+        static void loadTasksFromFile(const std::string& filename,
+            FileFormat format = FileFormat::Auto, LoadOptions options = {});
+        static void saveTasksToFile(const std::string& filename,
+            FileFormat format = FileFormat::Auto);
+        static int addTask(const std::string& desc, Priority prio, time_t due);
         static void deleteTask(int id);
         static void updateTask(int id,
             std::optional<std::string> desc = {},
@@ -78,7 +853,40 @@ namespace MyLibrary
         static void sortTasksByPriority(bool ascending = true);
         static void sortTasksByDueDate(bool ascending = true);
         static void filterTasksByStatus(bool completedStatus);
+        static void filterTasksByPriority(Priority prio);
         static void displayCompletionPercentage();
+        static std::optional<TaskRow> findTask(int id);
+        static TaskStats statistics();
+        static void displayStatistics();
+        static std::vector<TaskRow> runQuery(const TaskQuery& query);
+        static TaskCursor openCursor(const TaskQuery& query = {}, size_t pageSize = 20);
+
+        static std::vector<int> searchTasks(std::string_view query);
+        static void displaySearchResults(std::string_view query);
+        static size_t searchIndexBytes();
+
+        static DueCounts countDue(int fromDay, int toDay);
+        static std::vector<TaskRow> tasksDue(int fromDay, int toDay,
+            std::optional<bool> completed = {});
+        static void displayDueSummary(int soonDays = 7);
+
+        static void setConcurrentAccess(bool enabled);
+        static std::shared_ptr<const TaskSnapshot> snapshot();
+        static void writeBatch(const std::function<void()>& edits);
+
+        static void openJournal(const std::string& snapshotFile, JournalOptions options = {});
+        static void syncJournal();
+        static void compactJournal();
+        static void closeJournal(bool removeFile = false);
+        static void loadJournaledTasks(const std::string& snapshotFile);
+
+        static void startAutosave(const std::string& filename, AutosaveOptions options = {});
+        static void flushAutosave();
+        static void stopAutosave();
+
+        static void startReminders(std::function<void(const TaskRow&)> onDue, ReminderOptions options = {});
+        static size_t pollReminders();
+        static void stopReminders();
     };
 
 } // end namespace MyLibrary